@@ -0,0 +1,97 @@
+// --------------------------------------------------------------------
+//  CellGrid.h
+//
+//  A uniform grid as spatial index for the cells of a polygonal net.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CELLGRID_H
+#define CELLGRID_H
+
+#include <vtkPolyData.h>
+#include <vtkIdList.h>
+
+#include "RegionOfInterest.h"
+
+//! A spatial index for the cells of a polygonal net
+/*!
+  The polygons and triangle strips of a vtkPolyData are sorted into
+  a uniform grid of buckets, using the centroid of the cells. A query
+  for a \link RegionOfInterest \endlink only visits the buckets
+  overlapping the bounding box of the region, so the costs depend on
+  the size of the region and not on the size of the polygonal net.
+
+  A cell is in the region, if one of its vertices is in the region.
+*/
+class CellGrid
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor building the index for a polygonal net
+   /*!
+     The resolution of the grid is chosen to get about 16 cells in
+     a bucket.
+   */
+   CellGrid(vtkPolyData*);
+   //! Constructor building the index with n x n x n buckets
+   CellGrid(vtkPolyData*, int n);
+   //! Destructor
+   ~CellGrid(void);
+
+   //! Query the cells in the region
+   /*!
+     The ids are numbered like in vtkPolyData, polygons first, followed
+     by the triangle strips.
+   */
+   void getCells(RegionOfInterest*, vtkIdList*);
+   //! Query the vertices of all cells in the region
+   void getPoints(RegionOfInterest*, vtkIdList*);
+   //! Extract the cells in the region as a new vtkPolyData
+   /*!
+     The points and normals used by the cells are copied into the new
+     vtkPolyData, which has to be deleted by the caller.
+   */
+   vtkPolyData* extract(RegionOfInterest*);
+
+   //! Query the number of cells in the index
+   int getNumberOfCells(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The indexed polygonal net
+   vtkPolyData *mesh;
+   //! Number of buckets in x, y and z
+   int n[3];
+   //! Bounding box of the net
+   float box[6];
+   //! Size of a bucket in x, y and z
+   float size[3];
+   //! Maximal distance of a vertex to the centroid of its cell in x, y and z
+   float margin[3];
+   //! Number of cells, and the number of polygons
+   int numCells, numPolys;
+   //! Offset of the point ids of every cell in cellPoints
+   int *cellStart;
+   //! Point ids of all cells
+   int *cellPoints;
+   //! Offset of every bucket in bucketCells
+   int *bucketStart;
+   //! Cell ids sorted by buckets
+   int *bucketCells;
+   //! Marker for every point of the net, -1 if not used
+   int *mark;
+
+   // build the index
+   void build(int);
+   // test if a cell is in the region
+   bool cellInside(int, RegionOfInterest*);
+   // range of buckets overlapping the region
+   void bucketRange(RegionOfInterest*, int lo[3], int hi[3]);
+};
+#endif
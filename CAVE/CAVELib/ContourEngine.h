@@ -0,0 +1,181 @@
+// --------------------------------------------------------------------
+//  ContourEngine.h
+//
+//  Contouring of scalars on a polygonal net, the line segments are
+//  written directly into the vertex array of a Performer geoset.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CONTOURENGINE_H
+#define CONTOURENGINE_H
+
+#include <Performer/pr/pfGeoSet.h>
+
+#include "LightLine.h"
+
+//! A class computing isolines on a polygonal net into a geoset
+/*!
+  For every triangle and every contour value the isoline is a line
+  segment (marching triangles), polygons are split into a fan of
+  triangles. The segments are not stored in VTK objects, they are
+  written into the PFGS_COORD3 array of a geoset with primitive type
+  PFGS_LINES. The geoset references the array in the shared arena by
+  pointer, there is no copy between the contouring and the rendering.
+
+  The array of the geoset is reused by the next contouring, it is only
+  replaced if it is too small. The geoset must not be drawn while it
+  is written, see \link DoubleBuffer \endlink.
+
+  A contouring starts with ::begin(), the scalars of one or more
+  light lines are contoured with ::contour(), ::end() sets the
+  number of segments.
+
+  With ::setChunks() the segments are distributed over several
+  geosets, one for every cell of a uniform grid over a bounding box,
+  using the midpoint of a segment. Every geoset gets the bounding box
+  of its segments, so Performer culls the chunks with PFCULL_GSET for
+  every channel, e.g. every wall of the CAVE, on its own.
+
+  With ::setBand() every contour value is the center of a band of
+  scalars instead of an isoline. The triangles are clipped to the
+  interval of the band and the filled parts are written as PFGS_TRIS,
+  so a light cylinder is one band instead of many parallel lines. With
+  ::setProfile() the vertices get a color scaled with the attenuation
+  profile of the cylinder, the triangles are split at the center of
+  the band, so the profile peaks there.
+*/
+class ContourEngine
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, one contour value 0
+   ContourEngine(void);
+   //! Destructor
+   ~ContourEngine(void);
+
+   //! Set one contour value
+   void setValue(float);
+   //! Set n contour values, e.g. the values of a vtkContourFilter
+   void setValues(const float *values, int n);
+   //! Query the number of contour values
+   int  getNumberOfValues(void);
+
+   //! Split the segments into chunks, resolution cells along every axis of the box
+   /*!
+     A resolution of 1, the default, writes all segments into one geoset.
+   */
+   void setChunks(const float box[6], int resolution);
+   //! Query the number of chunks, the number of geosets for ::begin()
+   int  getNumberOfChunks(void);
+
+   //! Contour bands of half width float around the values instead of isolines
+   /*!
+     The geosets must have the primitive type PFGS_TRIS. 0, the
+     default, contours isolines into PFGS_LINES.
+   */
+   void  setBand(float halfWidth);
+   //! Query the half width of the bands, 0 for isolines
+   float getBand(void);
+   //! Color the vertices of the bands with the profile of the attenuation
+   /*!
+     The color of a vertex is the RGB color, scaled with the profile at
+     the distance of its scalar from the center of the band, alpha is 1.
+   */
+   void  setProfile(LightLine::Attenuation, const float color[3]);
+   //! The bands get the overall color of the geosets
+   void  setProfileOff(void);
+   //! Are the vertices of the bands colored with the profile?
+   bool  hasProfile(void);
+
+   //! Start the contouring into the geoset, its last segments are dropped
+   void begin(pfGeoSet*);
+   //! Start the contouring into one geoset for every chunk
+   void begin(pfGeoSet **gsets);
+   //! Contour the scalars of a polygonal net and append the segments
+   /*!
+     The arguments are the points, 3 floats for every point, the
+     polygons as connectivity of a vtkCellArray (number of points,
+     followed by the point ids), the number of polygons and one scalar
+     for every point.
+   */
+   void contour(const float *points, const int *polys, int numPolys,
+                const float *scalars);
+   //! Contour the scalars of triangle strips and append the segments
+   /*!
+     Like ::contour(), the strips are given as connectivity of a
+     vtkCellArray. A strip of n points has the triangles (i, i+1, i+2),
+     every second one is turned around.
+   */
+   void contourStrips(const float *points, const int *strips, int numStrips,
+                      const float *scalars);
+   //! Finish the contouring, the geoset is ready for the rendering
+   void end(void);
+   //! Is a contouring between ::begin() and ::end()?
+   bool isActive(void);
+
+   //! Query the number of line segments of the last contouring
+   int  getNumberOfSegments(void);
+   //! Query the number of band triangles of the last contouring
+   int  getNumberOfTriangles(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The contour values
+   float *values;
+   //! Number of contour values
+   int   numValues;
+
+   //! Half width of the bands, 0 for isolines
+   float  band;
+   //! Are the band vertices colored, with which profile and color?
+   bool   profile;
+   LightLine::Attenuation form;
+   float  color[3];
+
+   //! A geoset written and its vertex array
+   struct Target
+   {
+      pfGeoSet *gset;
+      pfVec3   *verts;
+      //! Number of vertices written and size of the vertex array
+      int      numVerts, capacity;
+      //! The vertex colors of the profile and the size of the array
+      pfVec4   *colors;
+      int      colorCapacity;
+   };
+
+   //! The geosets written, one for every chunk
+   Target *targets;
+   //! Is a contouring active?
+   bool   active;
+   //! Box of the chunks and number of cells along every axis
+   float  box[6];
+   int    resolution;
+
+   //! Contour one triangle
+   void contourTriangle(const float *p0, const float *p1, const float *p2,
+                        float s0, float s1, float s2);
+   //! Clip one triangle to the bands and append the filled parts
+   void bandTriangle(const float *p0, const float *p1, const float *p2,
+                     float s0, float s1, float s2);
+   //! Append the triangle fan of a convex polygon, the points carry their scalar
+   void addPolygon(float points[][4], int n, float center);
+   //! The point on the edge (a,b), where the scalar is value
+   void crossing(const float *a, const float *b, float sa, float sb, float value,
+                 float p[3]);
+   //! Append the segment (p,q) to the geoset of its chunk
+   void addSegment(const float p[3], const float q[3]);
+   //! The target of the chunk containing the point
+   Target& chunk(const float m[3]);
+   //! Replace the vertex array of a target by a larger one
+   void grow(Target&);
+   //! Replace the color array of a target by a larger one
+   void growColors(Target&);
+};
+#endif
@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------
+//  DoubleBuffer.h
+//
+//  Two buffers below a switch node, one is drawn, the other is written.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef DOUBLEBUFFER_H
+#define DOUBLEBUFFER_H
+
+//! Double buffering of geometry below a switch node
+/*!
+  The two buffers are the children 0 and 1 of the switch. The front
+  buffer is drawn, the back buffer is written by the application
+  process, then the buffers are swapped. Nothing is allocated in the
+  scene graph for a swap, only the value of the switch changes.
+
+  Switch is the class of the switch node, it needs a function
+  setVal(int), like pfSwitch. Buffer is the class of the children,
+  e.g. pfGeode. All is the value of the switch showing all children,
+  PFSWITCH_ON for pfSwitch. No OpenGL Performer header is needed, so
+  the class can be used with other scene graphs.
+
+  OpenGL Performer applies the value of a switch at the frame boundary,
+  but with the application, cull and draw process in a pipeline the
+  draw process sees it some frames later. Until then the old front
+  buffer may still be drawn. The latency is the number of frames, the
+  back buffer must not be written for this number of frames after the
+  last change of the switch, see ::backReady().
+*/
+template <class Switch, class Buffer, int All>
+class DoubleBuffer
+{
+public:
+   //! Constructor, the buffers have to be the children 0 and 1 of the switch
+   /*!
+     The first buffer is the front buffer. The default latency of 2
+     frames is the latency of the application, cull and draw process
+     running in separate processes.
+   */
+   DoubleBuffer(Switch *s, Buffer *first, Buffer *second, int l = 2)
+   {
+      switchNode = s;
+      buffers[0] = first;
+      buffers[1] = second;
+      front = 0;
+      latency = l;
+      lastChange = -latency;
+      switchNode->setVal(front);
+   }
+
+   //! The buffer drawn
+   inline Buffer* getFront(void) {return buffers[front];}
+   //! The buffer written by the application
+   inline Buffer* getBack(void) {return buffers[1-front];}
+   //! Query the index of the front buffer below the switch
+   inline int getFrontIndex(void) {return front;}
+
+   //! Set the number of frames the draw process is behind the application
+   inline void setLatency(int l) {latency = (l < 0) ? 0 : l;}
+   //! Query the number of frames the draw process is behind the application
+   inline int  getLatency(void) {return latency;}
+
+   //! Can the back buffer be written in this frame?
+   /*!
+     The back buffer is not drawn, if the last change of the switch is
+     at least latency frames ago.
+   */
+   inline bool backReady(int frame) {return frame - lastChange >= latency;}
+
+   //! The back buffer is drawn from now on, the front buffer is the new back buffer
+   void swap(int frame)
+   {
+      front = 1-front;
+      switchNode->setVal(front);
+      lastChange = frame;
+   }
+
+   //! Draw both buffers, e.g. to cross-fade from the back to the front buffer
+   void showBoth(int frame)
+   {
+      switchNode->setVal(All);
+      lastChange = frame;
+   }
+
+   //! Draw only the front buffer, e.g. at the end of a cross-fade
+   void showFront(int frame)
+   {
+      switchNode->setVal(front);
+      lastChange = frame;
+   }
+
+private:
+   //! The switch node
+   Switch *switchNode;
+   //! The children of the switch
+   Buffer *buffers[2];
+   //! Index of the front buffer
+   int    front;
+   //! Number of frames the draw process is behind the application
+   int    latency;
+   //! Frame of the last change of the switch
+   int    lastChange;
+};
+#endif
@@ -17,6 +17,7 @@
 #include <Performer/pf/pfLightSource.h>
 #include <Performer/pf/pfDCS.h>
 #include <Performer/pf/pfSwitch.h>
+#include <Performer/pf/pfGeode.h>
 #include <Performer/pr/pfGeoState.h>
 
 #include <vtkPolyData.h>
@@ -24,12 +25,25 @@
 #include "LightCage.h"
 #include "HighlightLines.h"
 #include "InterrogationObject.h"
+#include "DoubleBuffer.h"
+#include "LineLevels.h"
+#include "ScalarPreview.h"
 
 //! A class for a scene for surface interrogation
 /*!
   The scene contains an interrogated object, a light cage and
   interrogation lines. The lines are computed as isolines, using
   VTK, and rendered as OpenGL Performer lines.
+
+  The lines are double buffered: two \link LineLevels \endlink below a
+  switch, the computation writes the buffer which is not drawn and
+  swaps the buffers. Every buffer draws distant chunks of the lines
+  with a coarse level. After the first computation no nodes are
+  allocated.
+
+  With the preview mode, the fast interaction shows a
+  \link ScalarPreview \endlink instead of the lines while the light
+  cage is moved, the lines are computed when the motion stops.
 */
 class GeometryRoom : public Room
 {
@@ -94,8 +108,53 @@ void isophoteFastInteract(void);
 void reflectInteract(void);
 
 //! Compute the interrogation lines
+/*!
+  The level of the multi-resolution hierarchy set in the interrogation
+  lines is used. The time of a computation at full resolution is
+  measured for the choice of the level in the fast interaction.
+
+  The lines are written into the back buffer, which is swapped at the
+  next frame. If the back buffer is still drawn after the last swap,
+  the computation is done by one of the next calls of the interaction
+  functions.
+*/
 void compute(void);
 
+//! Set the frame budget for the fast interaction in seconds
+/*!
+  While the light cage is moved, the finest level of the multi-resolution
+  hierarchy is used, for which the computation fits into the budget. The
+  default is 1/30 seconds.
+*/
+void setFrameBudget(double);
+
+//! Switch the preview mode of the fast interaction on or off
+/*!
+  In the preview mode the fast interaction functions do not contour
+  while the light cage or the light vector is moved. The object is
+  shown with the texture map of
+  InterrogationLines::computePreviewTexture(), set once when the
+  preview starts, only the texture coordinates are computed in a
+  frame. When the joystick is
+  released, the lines are computed and replace the preview. The
+  default is off, then the coarse levels of the multi-resolution
+  hierarchy are used.
+*/
+void setPreview(bool);
+//! Query the preview mode of the fast interaction
+bool getPreview(void);
+
+//! Render light cylinders as filled bands
+/*!
+  Passed to InterrogationLines::setBands() by addLightObjects() if the
+  radius is > 0. The default is false like in InterrogationLines, the
+  cylinders are shown as several isolines. Set it before
+  addLightObjects().
+*/
+void setBands(bool);
+//! Query, if light cylinders are rendered as filled bands
+bool getBands(void);
+
 // build light cage
 // No computation is done!
 // -----------------------
@@ -106,6 +165,8 @@ virtual void addLightObjects(bool, bool, int, float, LightLine::Attenuation);
 virtual void addLightObjects(bool, int);
 virtual void addLightObjects(bool, int, LightLine::Attenuation);
 virtual void addLightObjects(bool, int, float, LightLine::Attenuation);
+// periodic stripes
+virtual void addPeriodicLightObjects(bool, int, float, LightLine::Attenuation);
 
 //! Build a light vector for working with isophotes
 /*!
@@ -138,6 +199,58 @@ private:
 
 //! The Performer group containing the lines geometry
 pfGroup       *hlinesGeometry;
+//! Switch above hlinesGeometry, the lines are hidden during the preview
+pfSwitch      *linesSwitch;
+//! Switch below hlinesGeometry with the two line buffers
+pfSwitch      *hlinesSwitch;
+//! The line buffers, the front buffer is drawn, the back buffer is computed
+/*!
+  Every buffer draws its chunks with two levels of detail.
+*/
+DoubleBuffer<pfSwitch, LineLevels, PFSWITCH_ON> *hlinesBuffers;
+//! True, if a computation waits for the back buffer
+bool          computePending;
+
+//! Time of the last computation at full resolution in seconds
+double        fullTime;
+//! Frame budget for the fast interaction in seconds
+double        frameBudget;
+//! True, if the lines displayed are computed on a coarse level
+bool          coarseLines;
+//! True while the coarse lines in the back buffer are faded out
+bool          fading;
+//! Number of frames for the cross-fade
+int           fadeFrames;
+//! Current frame of the cross-fade
+int           fadeStep;
+
+//! True, if the fast interaction shows the preview while the cage is moved
+bool          previewMode;
+//! The textured object of the preview, build at the first preview
+ScalarPreview *preview;
+//! Texture environment of the preview
+pfTexEnv      *previewEnv;
+//! Size of the texture map of the preview
+int           previewSize;
+//! True, while the preview replaces the lines
+bool          previewing;
+//! True, if light cylinders are rendered as filled bands
+bool          lightBands;
+
+//! Compute the lines on the finest level fitting into the frame budget
+void interactiveCompute(void);
+//! Compute the lines at full resolution and cross-fade from the coarse lines
+void refine(void);
+//! Next frame of the cross-fade
+void fade(void);
+//! Finish the cross-fade, only the front buffer is drawn
+void endFade(void);
+//! Set the alpha value of all lines in a geode
+void setLinesAlpha(pfGeode*, float);
+//! Show the texture coordinates of the moved cage in the preview
+void previewCompute(void);
+//! Compute the lines and replace the preview, if the line buffer is ready
+void endPreview(void);
 
 //! Create the scene tree, without reading any objects, only structure
 void createMasterScene(void);
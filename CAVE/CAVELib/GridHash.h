@@ -0,0 +1,68 @@
+// --------------------------------------------------------------------
+//  GridHash.h
+//
+//  Hash table of the occupied cells of a uniform grid, used by the
+//  vertex clustering of MeshHierarchy and VertexClusters.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef GRIDHASH_H
+#define GRIDHASH_H
+
+/*! \file
+  A grid with res x res x res cells of the size size[3] over a box
+  (xmin, xmax, ymin, ymax, zmin, zmax). The cell of a point is a 64 bit
+  key, the table of the occupied cells has a power of 2 entries, it is
+  searched with linear probing. Empty entries have the key ::noGridKey.
+*/
+
+//! Key of an empty entry of the hash table
+static const unsigned long long noGridKey = ~0ULL;
+
+//! Key of the grid cell of a point, points outside are put into the border cells
+/*!
+  64 bits, res^3 does not fit into an int for res > 1290.
+*/
+inline unsigned long long gridKey(const float p[3], const float box[6],
+                                  const float size[3], int res)
+{
+   int i, ix[3];
+
+   for (i=0; i<3; i++) {
+       ix[i] = (int)((p[i]-box[2*i])/size[i]);
+       if (ix[i] < 0) ix[i] = 0;
+       if (ix[i] > res-1) ix[i] = res-1;
+   }
+   return ((unsigned long long) ix[2]*res + ix[1])*res + ix[0];
+}
+
+//! The cell (x, y, z) of a key
+inline void gridCell(unsigned long long key, int res, int ix[3])
+{
+   ix[0] = (int)(key%res);
+   ix[1] = (int)((key/res)%res);
+   ix[2] = (int)(key/((unsigned long long) res*res));
+}
+
+//! First entry of a key in a table of tableSize entries, Fibonacci hashing
+inline int gridHash(unsigned long long key, int tableSize)
+{
+   return (int)((unsigned int)((key*11400714819323198485ULL) >> 32) & (tableSize-1));
+}
+
+//! Entry of the key in the table, or the empty entry where it belongs
+/*!
+  The table must not be full.
+*/
+inline int gridSlot(const unsigned long long *tableKeys, int tableSize,
+                    unsigned long long key)
+{
+   int h = gridHash(key, tableSize);
+
+   while ((tableKeys[h] != noGridKey) && (tableKeys[h] != key))
+      h = (h+1) & (tableSize-1);
+   return h;
+}
+#endif
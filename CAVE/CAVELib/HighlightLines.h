@@ -62,7 +62,10 @@ public:
    //! Compute the texture map
    /*!
      For highlight lines the texture map is computed as a representation
-     of the light cage geometry. So LightCage::computeTexture() is called.
+     of the light cage geometry. So LightCage::computeTexture() is called,
+     or LightPlaneTexture::computeTexture(), if a plane texture is set.
+     If a TextureCache is set, an unchanged texture map is not computed
+     again.
    */
    virtual pfTexture* computeTexture(int);
    //! Compute the texture coordinates
@@ -90,7 +93,53 @@ public:
    //! Save the computed texture map as vtkStructuredPoints
    virtual vtkScalars* saveTexture(int);
 
+   //! Store the texture shear of a parallel cage as second texture coordinate
+   /*!
+     Only possible with the texture of the cage, not with a plane texture.
+   */
+   virtual bool setTextureShear(TopParallelLightCage*);
+
+   //! Texture map of the preview, one band of the light form
+   /*!
+     The 1D map does not depend on the lines of the cage, it is cached
+     with the size and the attenuation only. The first texel is
+     transparent, the next and the last texel are outside of the band,
+     the texels between them are the light form from -1 to 1 times the
+     radius. The periodic cage uses its own texture map.
+   */
+   virtual pfTexture* computePreviewTexture(int);
+   //! Texture coordinates of the preview, the distance to the nearest line
+   /*!
+     The value of the line with the smallest absolute
+     LightLine::highlightValue() is mapped onto the band, so only the
+     coordinates move with the cage. Lines without a radius are shown
+     as bands of the radius of the cage, or of 1/100 of the diagonal
+     of the bounding box.
+   */
+   virtual void computePreviewCoordinates(int);
+   //! The center of the transparent first texel of the preview map
+   virtual void offPreviewCoordinates(int, float tc[2]);
+
 private:
+   //! The cage giving the texture shear, NULL if not used
+   TopParallelLightCage *shearCage;
+
+   //! Key of the texture map in the TextureCache
+   /*!
+     The hash of the lines of the cage, radius, attenuation, bounding
+     box, the size of the texture map, the prefilter flag and whether
+     a region of interest is used.
+   */
+   unsigned long long textureKey(int);
+   //! Half width of the band of the preview
+   float previewRadius(void);
+   //! Set the first texel of a texture map dark
+   /*!
+     Only used in a region of interest, the points outside of it get
+     the texture coordinates of the first texel.
+   */
+   void darkenFirstTexel(pfTexture*);
+
    //! Compute the scalars to contour 
    /*!
      We compute the scalars as vtkScalars, for an individual line in the
@@ -99,6 +148,20 @@ private:
      We use LightLine::highlightValue() for the computation.
    */
    virtual void computeScalars(vtkScalars*, list<LightLine>::iterator); 
-                               
+
+   //! The scalar value for one vertex, used for tiled meshes
+   /*!
+     We use LightLine::highlightValue() for the computation.
+   */
+   virtual float scalarValue(float point[3], float normal[3],
+                             list<LightLine>::iterator);
+
+   //! Texture coordinates of the dark texel reserved in the texture map
+   /*!
+     The corner texel of the light plane texture, the texel at the
+     border of the period of a periodic cage, or the first texel of
+     the texture of other cages.
+   */
+   virtual void offTextureCoordinates(float tc[2]);
 };
 #endif
@@ -20,11 +20,24 @@
 #include <vtkScalars.h>
 #include <vtkCellArray.h>
 #include <vtkRenderer.h>
+#include <vtkContourFilter.h>
+#include <vtkTCoords.h>
+#include <vtkIdList.h>
 
 #include "LightLine.h"
 #include "LightCage.h"
 #include "LightVector.h"
 #include "InterrogationObject.h"
+#include "TiledMesh.h"
+#include "RegionOfInterest.h"
+#include "CellGrid.h"
+#include "MeshHierarchy.h"
+#include "LightPlaneTexture.h"
+#include "TextureCache.h"
+#include "ContourEngine.h"
+#include "LineLevels.h"
+
+class TopParallelLightCage;
 
 //! A base class for interrogation lines
 /*!
@@ -34,6 +47,15 @@
 class InterrogationLines
 {
 public:
+   //! Default constructor
+   /*!
+     No tiled mesh is used, the interrogation lines are computed for
+     the polygonal data of the interrogated object.
+   */
+   InterrogationLines(void);
+   //! Destructor, releasing the texture coordinates of the region
+   virtual ~InterrogationLines(void);
+
    // scalars for the isolines
    //! Compute the lines
    /*!
@@ -57,6 +79,28 @@ public:
    //! Save the computed texture as vtkStructuredPoints
    virtual vtkScalars* saveTexture(int)=0;
 
+   //! Texture map of the preview while the cage is moved
+   /*!
+     The map must not depend on the position of the cage: it is
+     computed once when a preview starts, in every frame only
+     computePreviewCoordinates() is called. The default is
+     computeTexture().
+   */
+   virtual pfTexture* computePreviewTexture(int);
+   //! Texture coordinates of the preview for all points
+   /*!
+     The coordinates of the map of computePreviewTexture() with the
+     size given are stored in the vtkTCoords of the interrogated
+     object. The default is computeTextureCoordinates().
+   */
+   virtual void computePreviewCoordinates(int);
+   //! Texture coordinates of a transparent texel of the preview map
+   /*!
+     The vertices of the preview are mapped onto this texel until their
+     coordinates are computed. The default is offTextureCoordinates().
+   */
+   virtual void offPreviewCoordinates(int, float tc[2]);
+
    // call clearLines, if main is recomputing, to
    // delete all polylines
    //! Delete all polylines, so a recompute can be done
@@ -90,6 +134,66 @@ public:
    void getLines(pfGroup*);
    //! Get the lines as Performer Geode attached to a group node
    pfGroup* getLines(void);
+   //! Compute the lines directly into a geode
+   /*!
+     Like compute(), but the contours are not stored as VTK objects.
+     The \link ContourEngine \endlink writes the line segments into the
+     vertex arrays of the first geosets of the geode, one geoset for
+     every chunk, see setChunkResolution(). Only lines which are still
+     contoured with VTK are written into the other geosets by
+     fillLines(). The arrays, materials and geostates of the geode
+     are reused by the next computation.
+     The geode must not be drawn while it is written, see
+     \link DoubleBuffer \endlink.
+   */
+   void computeLines(pfGeode*);
+   //! Compute the lines into the geode of the levels and update the levels
+   /*!
+     Like computeLines(pfGeode*), afterwards the coarse level of every
+     chunk is built, see \link LineLevels \endlink.
+   */
+   void computeLines(LineLevels*);
+   //! Set the number of chunks along every axis of the bounding box
+   /*!
+     The segments of computeLines() are split into chunks, every chunk
+     is a geoset with its own bound, so every channel culls the chunks
+     outside of its view. The default is 4, 1 writes all segments into
+     one geoset. The resolution must not change after the first
+     computeLines() for a geode.
+   */
+   void setChunkResolution(int);
+   //! Query the number of chunks along every axis of the bounding box
+   int  getChunkResolution(void);
+   //! Render light cylinders as filled bands in computeLines()
+   /*!
+     If the radius is > 0, the contour engine clips the triangles to
+     the scalar interval [-radius, radius] of every light line and
+     writes the filled parts into the chunk geosets as triangles. One
+     contour pass and one geoset per chunk replace the numLines
+     isolines of a band. The default is false, compute() and the
+     textures are not changed.
+   */
+   void setBands(bool);
+   //! Query, if light cylinders are rendered as filled bands
+   bool getBands(void);
+   //! Color the bands with the attenuation profile of the light cage
+   /*!
+     The vertices of the bands get the line color scaled with the
+     profile of LightCage::getAttenuation(), the default is true. If
+     false, the bands have the line color.
+   */
+   void setBandProfile(bool);
+   //! Query, if the bands are colored with the attenuation profile
+   bool getBandProfile(void);
+   //! Write the lines into the geosets of a geode, starting with geoset int
+   /*!
+     In contrast to getLines() no new geode is build. The geosets of
+     the geode and their arrays are reused, if they are large enough,
+     geosets are only added if there are more polylines than before.
+     The geode must not be drawn while it is written, see
+     \link DoubleBuffer \endlink.
+   */
+   void fillLines(pfGeode*, int first = 0);
 
    //! Set the light used to interrogate 
    void setLightCage(LightCage*);
@@ -100,6 +204,80 @@ public:
    //! Set the surface to be interrogated
    void setInterrogationObject(InterrogationObject*);
 
+   //! Set a tiled version of the surface to be interrogated
+   /*!
+     If a TiledMesh is set, compute() contours the tiles one after the
+     other instead of the polygonal data of the interrogated object. Only
+     the tiles in the cache of the TiledMesh are kept in memory. While
+     a coarse level > 0 is set, the level of the hierarchy is contoured
+     instead. Use NULL to switch back to the interrogated object.
+   */
+   void setTiledMesh(TiledMesh*);
+   //! Query the tiled version of the surface to be interrogated
+   TiledMesh* getTiledMesh(void);
+
+   //! Set a cache for the texture maps
+   /*!
+     If a TextureCache is set, computeTexture() gives back the cached
+     texture map, if the parameters of the texture did not change.
+     Use NULL to switch the cache off.
+   */
+   void setTextureCache(TextureCache*);
+   //! Query the cache for the texture maps
+   TextureCache* getTextureCache(void);
+
+   //! Set the region of interest
+   /*!
+     If a region is set, the scalars, the contours and the texture
+     coordinates are only computed for the cells with a vertex in the
+     region. A spatial index of the interrogated object is build at the
+     first computation in a region. Use NULL to interrogate the whole
+     object. An empty region is ignored.
+   */
+   void setRegionOfInterest(RegionOfInterest*);
+   //! Query the region of interest
+   RegionOfInterest* getRegionOfInterest(void);
+
+   //! Set a multi-resolution hierarchy of the interrogated object
+   /*!
+     The hierarchy is used if a level > 0 is set with setLevel. Use
+     NULL to switch the hierarchy off.
+   */
+   void setMeshHierarchy(MeshHierarchy*);
+   //! Query the multi-resolution hierarchy
+   MeshHierarchy* getMeshHierarchy(void);
+   //! Set the level of the hierarchy used by compute()
+   /*!
+     Level 0 is the interrogated object itself, higher levels are
+     coarser. The texture coordinates are always computed for level 0.
+   */
+   void setLevel(int);
+   //! Query the level of the hierarchy used by compute()
+   int  getLevel(void);
+
+   //! Set a 2D texture of the light plane, used instead of the cage texture
+   /*!
+     Light cages with lines in more than one direction need a two-dimensional
+     texture map. If set, the texture map and the texture coordinates are
+     computed by the LightPlaneTexture. Use NULL to switch it off.
+
+     The lines own the texture: it is deleted with the lines or when
+     another texture is set.
+   */
+   void setPlaneTexture(LightPlaneTexture*);
+   //! Query the 2D texture of the light plane
+   inline LightPlaneTexture* getPlaneTexture(void) {return planeTexture;}
+
+   //! Store the texture shear of a parallel cage as second texture coordinate
+   /*!
+     For the one-dimensional texture of a parallel cage the second texture
+     coordinate is not used. If the shear of
+     TopParallelLightCage::computeTextureShear() is stored there, a
+     translation of the cage is a texture matrix. Gives back false if
+     the interrogation lines can not do this, use NULL to switch it off.
+   */
+   virtual bool setTextureShear(TopParallelLightCage*) {return false;}
+
    //! Set the radius of the light cylinders
    void  setRadius(float);
    //! Query the radius of the light cylinders
@@ -189,6 +367,44 @@ protected:
    //! Color in RGB float[3] used for the rendering of the interrogatin lines
    float       color[3];    // color to render the lines
 
+   //! Tiled version of the interrogated object, NULL if not used
+   TiledMesh *tiles;
+
+   //! Region of interest, NULL if the whole object is interrogated
+   RegionOfInterest *region;
+   //! Spatial index for the interrogated object, build for the first region
+   CellGrid *grid;
+   //! Points with texture coordinates computed in the last region
+   vtkIdList *regionPoints;
+   //! Texture coordinates computed in the last region
+   /*!
+     We keep a reference, so the pointer can not be reused by VTK for
+     other texture coordinates while we compare it.
+   */
+   vtkTCoords *regionTCoords;
+
+   //! Multi-resolution hierarchy of the interrogated object, NULL if not used
+   MeshHierarchy *hierarchy;
+   //! Level of the hierarchy used by compute()
+   int level;
+   //! Spatial index for the level used, build for the first region
+   CellGrid *levelGrid;
+
+   //! 2D texture of the light plane, NULL if the cage texture is used
+   LightPlaneTexture *planeTexture;
+
+   //! Cache for the texture maps, NULL if not used
+   TextureCache *textureCache;
+
+   //! Contouring into a geoset, active while computeLines() is running
+   ContourEngine *contourEngine;
+   //! Number of chunks along every axis for computeLines()
+   int chunkResolution;
+   //! Render light cylinders as filled bands in computeLines()?
+   bool bands;
+   //! Color the bands with the attenuation profile?
+   bool bandProfile;
+
    //! Toggle to determine, if texture maps are prefiltered.
    /*!
      Default is no. No really satisfying solution implemented at this moment.
@@ -209,9 +425,123 @@ protected:
                             // Here is the difference!
                             // pure virtual.
 
+   //! The scalar value for one vertex
+   /*!
+     Compute the scalar value to contour for a vertex given by
+     point and normal, and an individual line in the light cage. This
+     function is used for the tiles of a TiledMesh.
+   */
+   virtual float scalarValue(float point[3], float normal[3],
+                             list<LightLine>::iterator)=0;
+
+   //! Compute the scalars to contour for the points of a tile or a region
+   void computeTileScalars(vtkScalars*, vtkPolyData*, list<LightLine>::iterator);
+
+   //! Contour the tiles of the TiledMesh
+   /*!
+     Every tile is loaded once. For every tile the scalars for int lines
+     of the light cage, beginning with the iterator, are contoured.
+     The contours of a light line in all tiles are appended, so we get
+     one vtkPolyData for every light line as in compute().
+   */
+   void computeTiled(vtkContourFilter*, list<LightLine>::iterator, int);
+
+   //! Contour the stripes of a periodic light cage in one pass
+   /*!
+     The stripe coordinate of every point is computed once, the contour
+     filter gets one value for every stripe in the range of the
+     scalars. We get one vtkPolyData for all stripes. If bool is true,
+     the data is a region or a coarse level, not the interrogated object.
+   */
+   void computePeriodic(vtkContourFilter*, vtkPolyData*, bool);
+
+   //! Contour the scalars with the values of the contour filter
+   /*!
+     The scalars belong to the points of the polygonal data, the second
+     polygonal data is the copy of its structure used as input of the
+     filter. If the contour engine is active, it appends the segments to
+     its geoset and NULL is given back. Otherwise the contours are
+     given back as new vtkPolyData.
+   */
+   vtkPolyData* contourScalars(vtkContourFilter*, vtkPolyData*, vtkPolyData*,
+                               vtkScalars*);
+
+   //! Query, if the computation is restricted to a region of interest
+   bool useRegion(void);
+   //! Query, if a coarse level of the hierarchy is used
+   bool useCoarseLevel(void);
+   //! Query, if the tiles of the TiledMesh are contoured
+   /*!
+     The tiles are the finest level, they are not used if a coarse
+     level of the hierarchy is set.
+   */
+   bool useTiles(void);
+   //! Query, if the contour engine writes bands in this computation
+   bool useBands(void);
+   //! The polygonal data of the level used
+   /*!
+     This is the polygonal data of the interrogated object, if no
+     coarse level is used.
+   */
+   vtkPolyData* levelData(void);
+   //! The cells of the interrogated object in the region of interest
+   /*!
+     The cells are taken from the level used.
+     A new vtkPolyData is given back, the caller has to delete it.
+   */
+   vtkPolyData* extractRegion(void);
+   //! Prepare the texture coordinates for a region of interest
+   /*!
+     The points of the last region are switched off, they get the
+     texture coordinates of ::offTextureCoordinates(), so there are no
+     lines outside of the region. If the object has no texture
+     coordinates computed in a region, this is done for all points.
+     The points in the region are given back in the vtkIdList.
+   */
+   vtkTCoords* prepareRegionTextureCoordinates(vtkIdList*);
+   //! Texture coordinates of a dark texel reserved in the texture map
+   /*!
+     Points switched off are mapped onto this texel. The default is
+     (-100, 0.5): the texture is clamped in s, and its first texel
+     and the border are dark.
+   */
+   virtual void offTextureCoordinates(float tc[2]);
+   //! Prepare the texture coordinates for all points
+   /*!
+     New texture coordinates with 2 components are set for all points of
+     the interrogated object. The packed array of the coordinates is
+     given back in coo, for the batch functions like
+     LightCage::computeTextureCoordinates(const float*, const float*, int, float*).
+   */
+   vtkTCoords* prepareTextureCoordinates(float *&coo);
+   //! The points of the interrogated object as packed array, 3 floats for every point
+   const float* getPointArray(void);
+   //! The normals of the interrogated object as packed array, 3 floats for every point
+   const float* getNormalArray(void);
+
    //
    // private function, to convert between vtk lines and Performer
    //
    pfGeoSet* processPrim(vtkPolyData*, vtkCellArray*);
+   //! Write the lines into a geoset build by newLineSet(), the arrays are reused
+   void fillPrim(pfGeoSet*, vtkPolyData*, vtkCellArray*);
+   //! A geoset for lines with color, material and geostate, but no lines
+   /*!
+     The primitive type is PFGS_LINESTRIPS for fillPrim() or PFGS_LINES
+     for the contour engine.
+   */
+   pfGeoSet* newLineSet(int);
+   //! Set the current color with alpha 1 in a geoset build by newLineSet()
+   /*!
+     Vertex colors written by the contour engine are not changed, only
+     the material.
+   */
+   void setLineSetColor(pfGeoSet*);
+   //! Switch a chunk geoset build by newLineSet() between lines and bands
+   /*!
+     Bands are PFGS_TRIS drawn with a polygon offset in front of the
+     surface and without face culling.
+   */
+   void setChunkSetType(pfGeoSet*, bool);
 };
 #endif
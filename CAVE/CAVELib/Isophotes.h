@@ -62,8 +62,9 @@ public:
      For isophotes the texture map is computed as a 1D texture, representing
      one line.
      
-     This texture is stored as a pfTexture. It is set to wrap and lamp, the
-     border color is set to (0, 0, 0, 1).
+     This texture is stored as a pfTexture. It is clamped, the
+     border color is set to (0, 0, 0, 1). The first sixteenth of the
+     texture is a dark margin, the isophote values 0 ... 1 follow.
 
      The texture represents luminance values in a ramp, from white (1,1,1)
      to black (0,0,0), using int pixel for the ramp.
@@ -73,8 +74,8 @@ public:
    /*!
      Isophotes are isolines of light intensity, determined by the scalar
      product scal=<normal, light_direction>. The biggest intensity is given for
-     scal = 0, thats the color white for that vertex. White as a texture
-     coordinate is texcoord = 0.
+     scal = 0, thats the color white for that vertex. The texture
+     coordinate is scal, mapped behind the dark margin of the texture.
 
      No backfaces are culled, so isophotes are rendered for backfaces. Should
      be worked on.
@@ -110,11 +111,27 @@ private:
    */
    virtual void computeScalars(vtkScalars*, list<LightLine>::iterator); 
 
+   //! The scalar value for one vertex, used for tiled meshes
+   /*!
+     We use LightVector::isophoteValue() for the computation, the
+     iterator is a dummy.
+   */
+   virtual float scalarValue(float point[3], float normal[3],
+                             list<LightLine>::iterator);
+
    // preFilter for 2D (saveTextures computes 2D!
    void preFilter(int vh, int size, unsigned short *bigImage, 
                                     unsigned short *smallImage);
    // preFilter for 1D
    void preFilter(int size, unsigned short *bigImage,
                             unsigned short *smallImage);
+
+   //! Part of the texture map below the isophote value 0
+   /*!
+     The texels in the margin are dark. Switched off points, e.g.
+     outside of the region of interest, get s = -100, which is clamped
+     onto the first texel.
+   */
+   static const float darkMargin;
 };
 #endif
@@ -20,6 +20,8 @@
 
 #include "LightLine.h"
 
+class PeriodicLightCage;
+
 //! Base class representing a set of light lines or cylinders, called a cage.
 /*!
   A class representing a set of light lines or cylinders, called a light cage.
@@ -65,6 +67,24 @@ public:
 
    //! Compute texture coordinates for a given point and normal.
    virtual float* computeTextureCoordinates(float*, float*)=0;
+   //! Compute the texture coordinates for n vertices
+   /*!
+     The points and normals are packed arrays with 3 floats for every
+     vertex, 2 floats for every vertex are written into tcoords. This
+     version calls the function above for every vertex, derived classes
+     can do better.
+   */
+   virtual void computeTextureCoordinates(const float *points, const float *normals,
+                                          int n, float *tcoords)
+   {
+      float *co;
+
+      for (int i=0; i<n; i++) {
+          co = computeTextureCoordinates((float*) points+3*i, (float*) normals+3*i);
+          tcoords[2*i] = co[0]; tcoords[2*i+1] = co[1];
+          delete [] co;
+      }
+   }
 
    // These functions can be used to set the attenuation of the
    // lightlines. No inhomogenous lightcages with concern of the
@@ -160,6 +180,13 @@ public:
    //! Query the cage normal.
    virtual void   getCageNormal(float, float v[3])=0;
 
+   //! Query the periodic cage, NULL if the cage is not periodic
+   /*!
+     A periodic cage is not computed line by line, see
+     \link PeriodicLightCage \endlink.
+   */
+   virtual PeriodicLightCage* getPeriodic(void) {return NULL;}
+
    //! Turn prefiltering on
    inline void setPreFilterOn(void) {preFilterMap=true;}
    //! Turn prefiltering off
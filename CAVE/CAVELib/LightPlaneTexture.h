@@ -0,0 +1,158 @@
+// --------------------------------------------------------------------
+//  LightPlaneTexture.h
+//
+//  Two-dimensional texture map of the light plane of a light cage,
+//  for crisscross cages and lines in arbitrary directions.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef LIGHTPLANETEXTURE_H
+#define LIGHTPLANETEXTURE_H
+
+#include <Performer/pr/pfTexture.h>
+
+#include "LightLine.h"
+#include "LightCage.h"
+
+//! A class computing a 2D texture map of the light plane of a cage
+/*!
+  The lines of the cage are projected orthogonally into a plane spanned
+  by two coordinate axes, like in LightLine::luminance(float, float).
+  The default plane is the xy-plane at the height of the first line,
+  covering the bounding box of the cage. The texture coordinates of a
+  vertex are the intersection of the normal line and the light plane.
+
+  Lines parallel to one of the two axes give the same luminance in every
+  row or in every column of the texture map. For these lines one
+  profile for the rows and one profile for the columns is computed, a
+  texel is the maximum of the two profiles. All other lines are
+  rasterized row by row: in a row the distance to the line is linear in
+  the column, so only the texels inside the light band are visited.
+
+  The rows of the texture map are distributed to a number of threads.
+  Overlapping bands are combined with the maximum.
+*/
+class LightPlaneTexture
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, no cage
+   LightPlaneTexture(void);
+   //! Constructor for a light cage, the plane is set from the cage
+   LightPlaneTexture(LightCage*);
+   //! Copy constructor for the same cage and plane
+   /*!
+     The bands and profiles are not copied, they are computed again
+     with the next image.
+   */
+   LightPlaneTexture(const LightPlaneTexture&);
+   //! Destructor
+   ~LightPlaneTexture(void);
+
+   //! Set the light cage and the default plane of the cage
+   void setLightCage(LightCage*);
+   //! Set the light plane
+   /*!
+     The plane is spanned by the coordinate axes u and v (0=x, 1=y, 2=z)
+     at the given height on the third axis. The texture covers
+     [umin, umax] x [vmin, vmax].
+   */
+   void setPlane(int u, int v, float height,
+                 float umin, float umax, float vmin, float vmax);
+
+   //! Turn prefiltering on
+   /*!
+     The profiles of the lines parallel to the axes are the exact mean of
+     the light form over the texel. The other lines are sampled in the
+     texel center.
+   */
+   inline void setPreFilterOn(void) {preFilterMap=true;}
+   //! Turn prefiltering off
+   inline void setPreFilterOff(void) {preFilterMap=false;}
+
+   //! Set the number of threads used for the rasterization
+   inline void setNumberOfThreads(int n) {numThreads = (n < 1) ? 1 : n;}
+   //! Query the number of threads used for the rasterization
+   inline int  getNumberOfThreads(void) {return numThreads;}
+
+   //! Compute the luminance image
+   /*!
+     The image has size x size texels, stored row by row as intensity
+     and alpha with 8 bits each. The memory is allocated with pfMalloc
+     in the shared arena. The first texel is reserved, it is always
+     dark; switched off points are clamped onto it.
+   */
+   unsigned short* computeImage(int size);
+   //! Compute a 2D Performer texture for the cage
+   /*!
+     The size in int has to be a power of 2!
+   */
+   pfTexture* computeTexture(int size);
+
+   //! Compute the texture coordinates for a point and a normal
+   /*!
+     If the normal is parallel to the light plane the coordinates are
+     set outside [0,1]^2, so the border color is used.
+   */
+   void computeTextureCoordinates(float point[3], float normal[3],
+                                  float coo[2]);
+
+   //! Luminance for the distance pD >= 0 to a line, relative to the radius
+   static float profile(float pD, LightLine::Attenuation form);
+   //! Integral of the light form from 0 to t, relative to the radius
+   static float integrate(float t, LightLine::Attenuation form);
+   //! Mean luminance over the distances [a, b], relative to the radius
+   static float boxFilter(float a, float b, LightLine::Attenuation form);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! A line projected into the light plane
+   struct Band
+   {
+      float pu, pv;     // point
+      float du, dv;     // normalized direction
+      float radius;
+      LightLine::Attenuation form;
+   };
+
+   //! The light cage
+   LightCage *cage;
+   //! Axes spanning the light plane and the normal axis
+   int axis[3];
+   //! Height of the light plane on the normal axis
+   float height;
+   //! Range of the texture (umin, umax, vmin, vmax)
+   float range[4];
+   //! Number of threads
+   int numThreads;
+   //! Flag for the computation of a pre-filtered texture map
+   bool preFilterMap;
+
+   //! Lines parallel to v, giving the profile of the columns
+   Band *columnBands;
+   //! Lines parallel to u, giving the profile of the rows
+   Band *rowBands;
+   //! Lines in other directions
+   Band *bands;
+   int numColumnBands, numRowBands, numBands;
+
+   //! Profiles of the separable lines
+   float *columnProfile, *rowProfile;
+
+   // project the lines of the cage into the light plane
+   void collectBands(void);
+   // compute the rows [first, last) of the image
+   void rasterRows(unsigned short *image, int size, int first, int last);
+   // block of rows for runThreadBlocks, calling rasterRows
+   static void rasterBlock(void*, int, int);
+
+   // luminance of a band for the texel covering the distances [lo, hi]
+   float texel(float lo, float hi, Band &band);
+};
+#endif
@@ -88,6 +88,14 @@ public:
      We need a normalized normal vector.
    */
    float isophoteValue(float surfaceNormal[3]);
+   //! Compute the texture coordinates of n vertices for isophotes
+   /*!
+     The normals are a packed array with 3 floats for every vertex; the
+     isophote value v is mapped to lo + (1-lo)v, this and 0.5 are
+     written into tcoords for every vertex.
+   */
+   void  computeTextureCoordinates(const float *normals, int n, float lo,
+                                   float *tcoords);
 
    //! Get the geometry of the LightVector as a vtkLineSource
    /*!
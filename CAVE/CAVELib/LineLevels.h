@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------
+//  LineLevels.h
+//
+//  Level of detail for the chunks of the interrogation lines, one
+//  pfLOD for every chunk.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef LINELEVELS_H
+#define LINELEVELS_H
+
+#include <Performer/pf/pfGroup.h>
+#include <Performer/pf/pfGeode.h>
+#include <Performer/pf/pfLOD.h>
+#include <Performer/pr/pfGeoSet.h>
+
+//! A class drawing the chunks of the interrogation lines with two levels of detail
+/*!
+  InterrogationLines::computeLines() writes the segments into one
+  geoset for every chunk, the first geosets of the geode ::getGeode().
+  That geode is not in the scene graph. ::update() builds a pfLOD for
+  every chunk below ::getNode(), with the fine geoset and a coarse
+  geoset as children, so every channel, e.g. every wall of the CAVE,
+  draws distant chunks with fewer segments. The other geosets of the
+  geode, polylines computed with VTK, are drawn without a level of
+  detail.
+
+  The coarse level clusters the end points of the segments in a grid
+  with ::getCells() cells along every axis of a chunk, like
+  VertexClusters does for polygons. Every cluster is replaced by the
+  mean of its points, segments with both ends in one cluster are
+  dropped. The error is at most the diagonal of a cell. The coarse
+  level is drawn from the distance on, where the diagonal of a cell
+  is smaller than the pixel angle ::getPixelAngle(); the ranges are
+  scaled by the LOD scale of the channel.
+
+  Bands (PFGS_TRIS) are not simplified, both levels draw the arrays of
+  the fine geoset. The coarse geosets share the geostate and the colors
+  of the fine ones, so changing the alpha of the fine geosets fades
+  both levels.
+
+  The geosets are written only by ::update(), called after the
+  computation into the back buffer, see \link DoubleBuffer \endlink.
+*/
+class LineLevels
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, 8 cells and a pixel angle of 0.0015
+   LineLevels(void);
+   //! Destructor, the nodes belong to the scene graph
+   ~LineLevels(void);
+
+   //! The root of the levels, a child of the scene graph
+   pfGroup* getNode(void);
+   //! The geode written by InterrogationLines::computeLines()
+   pfGeode* getGeode(void);
+
+   //! Build the coarse levels after a computation
+   /*!
+     The box and the resolution are the ones of the chunks, see
+     InterrogationLines::setChunkResolution().
+   */
+   void update(const float box[6], int resolution);
+
+   //! Set the number of cells of the coarse level along every axis of a chunk
+   void setCells(int);
+   //! Query the number of cells of the coarse level along every axis of a chunk
+   int  getCells(void);
+   //! Set the angle of a pixel in radians, e.g. field of view/width
+   void  setPixelAngle(float);
+   //! Query the angle of a pixel in radians
+   float getPixelAngle(void);
+
+   //! Query the number of segments in the fine and in the coarse level
+   void getNumberOfSegments(int &fine, int &coarse);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Root of the levels
+   pfGroup *root;
+   //! The geode written by the computation, not in the scene graph
+   pfGeode *geode;
+   //! The geode with the geosets after the chunks
+   pfGeode *rest;
+   //! One pfLOD for every chunk
+   pfLOD   **lods;
+   //! The coarse geoset of every chunk
+   pfGeoSet **coarse;
+   //! Number of chunks of the nodes, resolution along every axis
+   int numChunks, resolution;
+   //! Number of geosets of the geode already in rest
+   int restSets;
+   //! Cells of the coarse level along every axis of a chunk
+   int cells;
+   //! Angle of a pixel in radians
+   float pixelAngle;
+   //! Number of segments of the last update
+   int fineSegments, coarseSegments;
+
+   //! Sum of the points in every cell of a chunk, 3 floats, cells^3 cells
+   float *sum;
+   //! Number of points in every cell of a chunk
+   int   *count;
+   //! Cell of every end point of the segments of a chunk
+   int   *pointCell;
+   //! Capacity of pointCell
+   int   pointCapacity;
+
+   // nodes for a new number of chunks
+   void build(int resolution);
+   // coarse level of a chunk with the box min, size
+   void simplify(pfGeoSet *fine, pfGeoSet *coarse, const float min[3],
+                 const float size[3]);
+   // add a point to its cell in the grid of a chunk
+   int cluster(const float p[3], const float min[3], const float size[3]);
+};
+#endif
@@ -0,0 +1,73 @@
+// --------------------------------------------------------------------
+//  MeshHierarchy.h
+//
+//  A hierarchy of simplified versions of a polygonal net, used for
+//  interrogation at a coarse level while the light cage is moved.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef MESHHIERARCHY_H
+#define MESHHIERARCHY_H
+
+#include <vtkPolyData.h>
+
+//! A class representing a multi-resolution hierarchy of a polygonal net
+/*!
+  Level 0 is the polygonal net itself. Every further level has about a
+  quarter of the triangles of the level before.
+
+  The levels are computed with quadric error clustering: the vertices
+  are clustered in a uniform grid, and every cluster is replaced by
+  the point minimizing the sum of the squared distances to the planes
+  of the triangles of the cluster. The normal of a cluster is the
+  average of the normals of its vertices, so the highlight and
+  reflection functions are smooth on all levels. Triangles with two
+  vertices in the same cluster are removed.
+
+  The levels are only computed once, when the hierarchy is build.
+*/
+class MeshHierarchy
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor building the hierarchy
+   /*!
+     Build int levels, including the polygonal net as level 0. The
+     polygonal net should contain point normals.
+   */
+   MeshHierarchy(vtkPolyData*, int);
+   //! Destructor, deleting the simplified levels
+   ~MeshHierarchy(void);
+
+   //! Query the number of levels
+   int getNumberOfLevels(void);
+   //! Query the polygonal data of a level
+   /*!
+     Level 0 is the original polygonal net, the highest level is the
+     coarsest one.
+   */
+   vtkPolyData* getLevel(int);
+   //! Query the number of triangles of a level
+   int getNumberOfTriangles(int);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Number of levels, including the original net
+   int numLevels;
+   //! The levels, level[0] is the original net
+   vtkPolyData **level;
+   //! Number of triangles of every level
+   int *triangles;
+
+   // triangulate the polygons and strips of a net
+   int triangulate(vtkPolyData*, int*&);
+   // quadric error clustering with a grid of the given resolution
+   vtkPolyData* simplify(vtkPolyData*, int*, int, int, int&);
+};
+#endif
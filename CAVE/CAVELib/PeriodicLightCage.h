@@ -0,0 +1,186 @@
+// --------------------------------------------------------------------
+//  PeriodicLightCage.h
+//  A light plane with a periodic pattern of parallel stripes, for
+//  zebra patterns with many lines.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef PERIODICLIGHTCAGE_H
+#define PERIODICLIGHTCAGE_H
+#include <list.h>
+
+#include <Performer/pf/pfGroup.h>
+#include <Performer/pr/pfLinMath.h>
+#include <Performer/pr/pfTexture.h>
+
+#include "LightCage.h"
+
+//! A light cage with infinitely many parallel stripes in a plane
+/*!
+  The light plane is parallel to the top plane of the bounding box of
+  an object, like for \link TopParallelLightCage \endlink. The stripes
+  are parallel, with a constant spacing, width and attenuation. The
+  pattern is described by the stripe coordinate of a point x in the
+  plane,
+
+     u(x) = (<x, a> - phase)/spacing,
+
+  with a the unit vector in the plane orthogonal to the stripes. The
+  centers of the stripes are at the integer values of u. The stripe
+  coordinate of a vertex is u at the intersection of the normal line
+  and the light plane.
+
+  Nothing depends on the number of stripes: the texture map contains
+  one period and is repeated in s, the texture coordinate of a vertex
+  is u + 1/2. For geometry the stripe coordinate is contoured at the
+  integers in one pass, see InterrogationLines::compute(). The
+  luminance in a texel or a vertex costs the same for 2 or 200 stripes.
+
+  The lines of the LightCage base class are only used to render the
+  cage: one line for every stripe crossing the bounding box. Rotations
+  are only supported around the normal of the plane.
+*/
+class PeriodicLightCage : public LightCage
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor based on the bounding box of an object
+   /*!
+     If bool is true the stripes are parallel to the y-axis, if false
+     parallel to the x-axis. The floats are the spacing of the stripes
+     and their width; the radius of the cage is half the width. A
+     stripe is centered in the box.
+
+     We elevate the light plane; 50% of the height of the bounding
+     box, like in TopParallelLightCage.
+   */
+   PeriodicLightCage(float box[6], bool, float spacing, float width,
+                     LightLine::Attenuation form);
+   //! Copy-Constructor
+   PeriodicLightCage(const PeriodicLightCage&);
+
+   //! The cage is periodic
+   virtual PeriodicLightCage* getPeriodic(void) {return this;}
+
+   //! Set the distance of two neighbouring stripes
+   void  setSpacing(float);
+   //! Query the distance of two neighbouring stripes
+   float getSpacing(void);
+   //! Set the width of the stripes, the radius of the cage is half the width
+   void  setWidth(float);
+   //! Query the width of the stripes
+   float getWidth(void);
+   //! Set the position of the stripe with u = 0 along the unit vector a
+   void  setPhase(float);
+   //! Query the position of the stripe with u = 0
+   float getPhase(void);
+   //! Query the height of the light plane
+   float getHeight(void);
+
+   //! Query the range of stripes contoured for geometry
+   /*!
+     The stripe coordinates first, ..., last cover the bounding box,
+     extended by its size on every side. Normal lines leaving the
+     extended box hit the plane far from the object.
+   */
+   void  getStripeRange(int &first, int &last);
+
+   //! The stripe coordinate u of a point and a normal
+   /*!
+     For a normal parallel to the light plane the normal is tilted by
+     1.0E-8, so u is far outside the stripe range.
+   */
+   float stripeValue(float point[3], float normal[3]);
+   //! The stripe coordinates of n vertices given as packed arrays
+   void  stripeValues(const float *points, const float *normals, int n,
+                      float *values);
+
+   //! Compute the luminance, given the lookup-vector ray
+   /*!
+     The ray in texture space [-1,1]^3 starts in the center of the
+     bounding box. Rays not hitting the light plane give 0.
+   */
+   virtual float luminance(pfVec3 ray);
+   //! Compute the luminance for the texture coordinate c
+   /*!
+     c is the texture coordinate u + 1/2, only the fraction is used.
+     The second coordinate is ignored.
+   */
+   virtual float luminance(float c, float d);
+
+   //! Compute the texture map of one period
+   /*!
+     A one-dimensional Performer texture, repeated in s. The
+     size in int has to be a power of 2! With prefiltering every texel
+     is the exact mean of the light form over the texel. If the
+     stripes leave a gap between them, the texels at the border of
+     the period are dark and switched off points are mapped onto
+     them. Stripes with a radius of about half the spacing or more
+     cover the border; it is not darkened, and switched off points
+     get the light of the border.
+   */
+   virtual pfTexture* computeTexture(int);
+   //! Compute and save the texture map of one period
+   virtual vtkScalars* saveTexture(int);
+
+   //! Compute the texture coordinates (u + 1/2, 1/2)
+   /*!
+     For a normal parallel to the light plane the coordinates are
+     (0, 1/2), the dark texels at the border of the period. The texture
+     repeats in s, so there is no border color.
+   */
+   virtual float* computeTextureCoordinates(float*, float*);
+   //! Compute the texture coordinates for n vertices
+   virtual void computeTextureCoordinates(const float *points, const float *normals,
+                                          int n, float *tcoords);
+
+   //! Query the bounding box as a float array (xmin, xmax, ymin, ymax, zmin, zmax)
+   float* getBBox(void);
+
+   //! Query the normal.
+   virtual float* getCageNormal(float);
+   //! Query the normal.
+   virtual void getCageNormal(float, float v[3]);
+
+   //! Translate the light plane
+   /*!
+     The translation in the plane changes the phase, the translation
+     in z the height.
+   */
+   virtual void translate(float, float, float);
+   //! Rotate the stripes around the normal of the plane
+   /*!
+     First argument is the angle in degrees, followed by the rotation
+     axis. Rotations around other axes are ignored.
+   */
+   virtual void rotate(float, float, float, float);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Axis parallel bounding box (xmin, xmax, ymin, ymax, zmin, zmax)
+   float BBox[6];
+   //! Unit vector in the plane orthogonal to the stripes
+   float across[2];
+   //! Position of the stripe with u = 0 along across
+   float phase;
+   //! Distance of two neighbouring stripes
+   float spacing;
+   //! Height of the light plane
+   float height;
+
+   // build the lines rendering the cage
+   void buildLines(void);
+   // range of <x, across> over the bounding box
+   void acrossRange(float &lo, float &hi);
+   // luminance for the fraction f of a period, stripe center at 1/2
+   float periodLuminance(float f);
+   // compute the image of one period
+   unsigned short* computeImage(int size);
+};
+#endif
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------
+//  PolyDataStream.h
+//
+//  Read a VTK file with polygonal data section by section, without
+//  keeping the data in memory.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef POLYDATASTREAM_H
+#define POLYDATASTREAM_H
+#include <stdio.h>
+
+//! A class reading a VTK polydata file as a stream
+/*!
+  vtkPolyDataReader builds the whole polygonal net in memory. For
+  objects bigger than the main memory the file is read with this class
+  instead: the sections of the file (POINTS, POLYGONS, TRIANGLE_STRIPS,
+  POINT_DATA, NORMALS, ...) are read one after the other, and the data
+  of a section is read in pieces of any size into the buffers of the
+  caller.
+
+  Attribute sections not needed by the caller, e.g. the SCALARS of a
+  CELL_DATA section, are skipped with ::skipAttribute().
+
+  Only the VTK legacy format is read, ASCII and BINARY. Binary files
+  are big endian, the data is swapped on little endian machines.
+  Points and normals have to be float.
+*/
+class PolyDataStream
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Open the file and read the header up to the DATASET line
+   PolyDataStream(const char *file);
+   //! Destructor, closing the file
+   ~PolyDataStream(void);
+
+   //! Is the file a VTK file with polygonal data?
+   bool isValid(void);
+
+   //! Read the header line of the next section
+   /*!
+     The data of the section before has to be read or skipped. The
+     keyword and the first two numbers of the line are given back,
+     e.g. POLYGONS n size. Numbers not in the line are set to 0. false
+     is given back at the end of the file.
+   */
+   bool nextSection(char keyword[64], int &n, int &size);
+
+   //! Read floats of the current section
+   /*!
+     Gives back the number of floats read.
+   */
+   int  readFloats(float*, int);
+   //! Read integers of the current section
+   /*!
+     Gives back the number of integers read.
+   */
+   int  readInts(int*, int);
+   //! Skip integers of the current section
+   void skipInts(int);
+   //! Skip n values of a VTK data type, e.g. float or unsigned_char
+   void skipValues(int n, const char *type);
+   //! Skip the data of the attribute section read last
+   /*!
+     The section is one of SCALARS, COLOR_SCALARS, LOOKUP_TABLE,
+     VECTORS, NORMALS, TEXTURE_COORDINATES, TENSORS or FIELD, tuples is
+     the number of the enclosing POINT_DATA or CELL_DATA section. false
+     is given back for other keywords, the rest of the file can not be
+     read then.
+   */
+   bool skipAttribute(const char *keyword, int tuples);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The file
+   FILE *fp;
+   //! Is the data binary?
+   bool binary;
+   //! Has the binary data to be swapped?
+   bool swap;
+   //! Was the header read?
+   bool valid;
+   //! The header line of the current section
+   char header[256];
+
+   // swap 4 bytes of every word
+   void swapWords(void*, int);
+   // size of a VTK data type in a binary file
+   int typeSize(const char*);
+};
+#endif
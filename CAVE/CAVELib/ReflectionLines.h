@@ -99,6 +99,16 @@ private:
    */
    virtual void computeScalars(vtkScalars*, list<LightLine>::iterator); 
 
+   //! The scalar value for one vertex, used for tiled meshes
+   /*!
+     We use LightLine::reflectionValue() and the eye point.
+   */
+   inline virtual float scalarValue(float point[3], float normal[3],
+                                    list<LightLine>::iterator line)
+   {
+      return line->reflectionValue(point, normal, eyePoint);
+   }
+
    // auxialiary function to help prefiltering the textures maps.
  
    void preFilter(int, float*, float*);
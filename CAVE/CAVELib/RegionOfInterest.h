@@ -0,0 +1,119 @@
+// --------------------------------------------------------------------
+//  RegionOfInterest.h
+//
+//  A region of interest for the interrogation: a box, a sphere or
+//  the volume swept by the wand.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef REGIONOFINTEREST_H
+#define REGIONOFINTEREST_H
+
+//! A class representing a region of interest on the interrogated object
+/*!
+  Designers often look at one part of an object only, a fender or a door
+  line. If a region of interest is set in \link InterrogationLines \endlink
+  the scalars, the contours and the texture coordinates are only computed
+  for the cells with at least one vertex in the region.
+
+  A region is an axis parallel box, a sphere or the volume swept by
+  the wand. The swept volume is the union of capsules with a fixed radius
+  around the path of wand positions given with
+  RegionOfInterest::addSample().
+
+  All coordinates are given in the coordinate system of the
+  interrogated object.
+*/
+class RegionOfInterest
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! The shape of the region
+   enum Shape {Box, Sphere, Swept};
+
+   //! Default constructor
+   /*!
+     An empty swept volume with radius 0.1 is build.
+   */
+   RegionOfInterest(void);
+   //! Copy-Constructor
+   RegionOfInterest(const RegionOfInterest&);
+   //! Constructor for an axis parallel box (xmin, xmax, ymin, ymax, zmin, zmax)
+   RegionOfInterest(float box[6]);
+   //! Constructor for a sphere, given by center and radius
+   RegionOfInterest(float center[3], float radius);
+   //! Constructor for a volume swept by the wand
+   /*!
+     The float is the radius of the capsules around the path of the wand.
+     No samples are given, so the region is empty.
+   */
+   RegionOfInterest(float radius);
+   //! Destructor
+   ~RegionOfInterest(void);
+
+   //! Query the shape of the region
+   Shape getShape(void);
+
+   //! Query, if the region is empty
+   /*!
+     A swept volume without samples is empty. An empty region is ignored
+     in the interrogation, so the whole object is interrogated.
+   */
+   bool isEmpty(void);
+
+   //! Test if a point is in the region
+   bool inside(float p[3]);
+
+   //! Query the bounding box of the region (xmin, xmax, ymin, ymax, zmin, zmax)
+   void getBounds(float b[6]);
+
+   //! Test if an axis parallel box intersects the bounding box of the region
+   bool intersects(float b[6]);
+
+   //! Add a wand position to a swept volume
+   /*!
+     A position is only stored if it is more than half the radius away from
+     the last sample, so the number of samples stays small. The function
+     gives back true, if the region changed.
+     For boxes and spheres nothing happens.
+   */
+   bool addSample(float p[3]);
+
+   //! Delete all samples of a swept volume
+   void clear(void);
+
+   //! Query the number of samples in a swept volume
+   int getNumberOfSamples(void);
+
+   //! Query the radius of a sphere or a swept volume
+   float getRadius(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Shape of the region
+   Shape shape;
+   //! Bounding box (xmin, xmax, ymin, ymax, zmin, zmax)
+   float bounds[6];
+   //! Center of a sphere
+   float center[3];
+   //! Radius of a sphere or of the capsules of a swept volume
+   float radius;
+   //! Wand positions of a swept volume, 3 floats for every sample
+   float *samples;
+   //! Number of samples
+   int numSamples;
+   //! Number of samples allocated
+   int maxSamples;
+
+   // distance of p to the segment between the samples i and i+1
+   float segmentDistance(float p[3], int i);
+   // enlarge the bounding box with a sample
+   void addToBounds(float p[3]);
+};
+#endif
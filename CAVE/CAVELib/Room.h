@@ -23,8 +23,11 @@
 #include "LightVector.h"
 #include "TopParallelLightCage.h"
 #include "TopCrissCrossLightCage.h"
+#include "PeriodicLightCage.h"
 #include "InterrogationObject.h"
 #include "InterrogationLines.h"
+#include "RegionOfInterest.h"
+#include "MeshHierarchy.h"
 
 //! Base class for creating and managing a scene for surface interrogation
 /*!
@@ -34,6 +37,11 @@
 class Room
 {
 public:
+//! Default constructor
+/*!
+  No region of interest and no multi-resolution hierarchy is used.
+*/
+Room(void);
 
 //! Set the pointer hlines to an existing subclass of \link InterrogationLines \endlink
 void setInterrogationLines(InterrogationLines*);
@@ -192,6 +200,19 @@ virtual void addLightObjects(bool, int, LightLine::Attenuation)=0;
 */
 virtual void addLightObjects(bool, int, float, LightLine::Attenuation)=0;
 
+//! Build a periodic light cage for zebra patterns
+/*!
+  The bool switches between vertical and horizontal stripes.
+  The int argument defines the number of stripes across the bounding
+  box of the interrogated object, the float argument the width of a
+  stripe relative to the spacing. The last argument determines the
+  attenuation wanted. See \link PeriodicLightCage \endlink; the costs
+  do not depend on the number of stripes.
+
+  Only the light cage is build. No interrogation lines are computed!
+*/
+virtual void addPeriodicLightObjects(bool, int, float, LightLine::Attenuation)=0;
+
 //! Toggle the visibility of the interrogation lines
 void toggleLight(void);
 //! Toggle the visibility of the light cage
@@ -225,6 +246,35 @@ void getNavigationInfo(pfDCS*);
 
 //! set the radius of all lines in the light cage
 void setCageRadius(float);
+//! Set the region of interest for the interrogation
+/*!
+  The region is given to the interrogation lines, so only the part of
+  the object in the region is interrogated. Use NULL for the whole object.
+*/
+void setRegionOfInterest(RegionOfInterest*);
+//! Query the region of interest
+RegionOfInterest* getRegionOfInterest(void);
+//! Delete all samples of a region swept by the wand
+void clearRegionOfInterest(void);
+//! Sweep the region of interest with the wand
+/*!
+  If the region is a volume swept by the wand, the wand position is
+  added to the region while Button 4 is pressed. Pressing Button 4
+  starts a new region. The wand position is
+  transformed into the coordinate system of the interrogated object.
+  The function gives back true, if the region changed.
+*/
+bool sweepRegionOfInterest(void);
+
+//! Build a multi-resolution hierarchy of the interrogated object
+/*!
+  The int argument is the number of levels, including the object itself.
+  The hierarchy is given to the interrogation lines. The fast interaction
+  functions use a coarse level while the light cage is moved.
+*/
+void buildMeshHierarchy(int);
+//! Query the multi-resolution hierarchy, NULL if not build
+MeshHierarchy* getMeshHierarchy(void);
 //
 // protected data
 //
@@ -290,6 +340,10 @@ float         navigationSpeed;
   Should prevent to busy interaction.
 */
 float         navigationThreshold;
+//! Region of interest, NULL if the whole object is interrogated
+RegionOfInterest *region;
+//! Multi-resolution hierarchy of the interrogated object, NULL if not used
+MeshHierarchy *hierarchy;
 
 //! Create the scene tree, without reading any objects, only structure
 virtual void createMasterScene(void)=0;
@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------
+//  ScalarPreview.h
+//
+//  A textured copy of the interrogated object, shown instead of the
+//  interrogation lines while the light cage is moved.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef SCALARPREVIEW_H
+#define SCALARPREVIEW_H
+
+#include <Performer/pf/pfSwitch.h>
+#include <Performer/pf/pfGeode.h>
+#include <Performer/pr/pfGeoSet.h>
+#include <Performer/pr/pfGeoState.h>
+#include <Performer/pr/pfTexture.h>
+#include <Performer/pr/pfMaterial.h>
+
+#include <vtkPolyData.h>
+
+#include "DoubleBuffer.h"
+
+//! A preview of the interrogation lines as texture map on the object
+/*!
+  Contouring a large object in every frame is too slow for the fast
+  interaction. The preview shows the object with the texture map of
+  the interrogation lines instead, e.g. the 1D band texture of the
+  light cage. In a frame only the texture coordinates of the vertices
+  are written, there is no contouring and the geometry is not built
+  again.
+
+  The triangles are built once by the constructor, polygons are split
+  into fans. Performer index lists are unsigned shorts, so every
+  triangle has its own three vertices. The vertices and normals are
+  shared by two geodes below a \link DoubleBuffer \endlink, every geode
+  has its own texture coordinates and its own geostate, so the
+  coordinates of the next frame are written while the last ones are
+  drawn.
+*/
+class ScalarPreview
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Build the triangles of the polygonal data, the material has the color
+   /*!
+     off are the texture coordinates of a transparent texel, e.g. of
+     InterrogationLines::offPreviewCoordinates(). They are drawn until
+     the first ::update().
+   */
+   ScalarPreview(vtkPolyData*, const float color[3], const float off[2]);
+   //! Destructor
+   ~ScalarPreview(void);
+
+   //! The node of the preview, to be added to the scene graph
+   pfSwitch* getNode(void);
+   //! Show or hide the preview
+   void show(bool);
+   //! Is the preview shown?
+   bool isShown(void);
+
+   //! Set the texture map and the texture environment
+   /*!
+     Both are referenced by the geostates of the two geodes, e.g. the
+     texture of InterrogationLines::computePreviewTexture().
+   */
+   void setTexture(pfTexture*, pfTexEnv*);
+   //! Can the texture coordinates be written in the frame?
+   bool backReady(int frame);
+   //! Write the texture coordinates and draw them from the next frame
+   /*!
+     The texture coordinates are given for every point of the polygonal
+     data, 2 floats each. Nothing is written, if ::backReady() is false.
+   */
+   void update(const float *tcoords, int frame);
+
+   //! Query the number of triangles
+   int  getNumberOfTriangles(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The node of the preview, switched on and off by ::show()
+   pfSwitch   *node;
+   //! Switch below the node with the two geodes
+   pfSwitch   *bufferSwitch;
+   //! The geodes, the front geode is drawn, the back geode is written
+   DoubleBuffer<pfSwitch, pfGeode, PFSWITCH_ON> *buffers;
+   //! Material of the triangles, shared by the geostates of the geodes
+   pfMaterial *material;
+   //! The point of every vertex of the triangles
+   int        *corners;
+   //! Number of vertices, 3 for every triangle
+   int        numCorners;
+   //! Is the preview shown?
+   bool       shown;
+
+   //! A geoset of the triangles with its own texture coordinates
+   pfGeoSet* newTriangleSet(pfVec3 *coords, pfVec3 *normals, const float off[2]);
+};
+#endif
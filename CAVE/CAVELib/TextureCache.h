@@ -0,0 +1,126 @@
+// --------------------------------------------------------------------
+//  TextureCache.h
+//
+//  Cache of computed texture maps, addressed by a hash of the
+//  parameters they are computed from.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+#include <list.h>
+#include <iostream.h>
+
+#include <Performer/pr/pfTexture.h>
+
+//! A class caching the texture maps of light cages
+/*!
+  Computing the texture map of a light cage is expensive, and uploading
+  it to the graphics hardware too. Often the cage did not change, only
+  the texture coordinates did. The texture maps are stored with a key,
+  a 64 bit FNV-1a hash of everything the texture is computed from:
+  the lines of the cage, their radius and attenuation, the size of the
+  texture map and the prefilter flag. ::hash() is used to build the key.
+
+  The textures in memory are kept in a LRU cache with a fixed number of
+  entries. The cache owns the textures: it holds a reference of every
+  texture in memory with ref() and releases it with unrefDelete() when
+  the texture is evicted, so a texture still used in the scene graph is
+  not freed. Users of the cache must not delete a texture given back by
+  ::lookup() or inserted with ::insert(), pfDelete does nothing while
+  the cache holds it.
+
+  If a directory is given the images are also written into that
+  directory, one file for every key. A texture not found in memory is
+  read from there, even in a later session. Files read from disk are
+  PFTEX_IA_8 textures with a black border and the wrap mode in s of the
+  texture written, mipmaps are computed again.
+*/
+class TextureCache
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor for a cache in memory with a number of entries
+   TextureCache(int capacity);
+   //! Constructor for a cache in memory and on disk
+   /*!
+     The directory is created, if it does not exist.
+   */
+   TextureCache(int capacity, const char *directory);
+   //! Destructor, the textures in memory are deleted
+   ~TextureCache(void);
+
+   //! The hash of an empty key
+   static const unsigned long long emptyKey;
+   //! Add bytes to a key
+   /*!
+     Start with TextureCache::emptyKey and add all parameters of the
+     texture map.
+   */
+   static unsigned long long hash(unsigned long long key, const void *data, int bytes);
+
+   //! Query a texture
+   /*!
+     NULL is given back, if the texture is neither in memory nor on disk.
+   */
+   pfTexture* lookup(unsigned long long key);
+   //! Insert a computed texture, the cache takes a reference
+   void insert(unsigned long long key, pfTexture*);
+
+   //! Set the number of textures in memory
+   void setCapacity(int);
+   //! Query the number of textures in memory
+   int  getCapacity(void);
+   //! Query the number of textures actually in memory
+   int  getNumberOfTextures(void);
+
+   //! Query how often a texture was found in memory
+   int getHits(void);
+   //! Query how often a texture was read from disk
+   int getDiskHits(void);
+   //! Query how often a texture had to be computed
+   int getMisses(void);
+
+   //! Delete all textures in memory, the files on disk are kept
+   void flush(void);
+
+   //! Print the cache statistics
+   void printStatistics(ostream&);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! A texture in memory
+   struct Entry
+   {
+      unsigned long long key;
+      pfTexture *texture;
+   };
+
+   //! Textures in memory, the most recently used is the first element
+   list<Entry> lru;
+   //! Number of textures in memory
+   int capacity;
+   //! Directory of the disk cache, NULL if not used
+   char *directory;
+   //! Statistics
+   int hits, diskHits, misses;
+
+   // compound function to set the members to default values
+   void init(int, const char*);
+   // release the least recently used texture
+   void evict(void);
+   // put a new texture in front of the LRU list and reference it
+   void remember(unsigned long long, pfTexture*);
+   // r/w a texture on disk
+   void writeTexture(unsigned long long, pfTexture*);
+   pfTexture* readTexture(unsigned long long);
+   // file name of a texture
+   void textureFileName(unsigned long long, char*);
+};
+#endif
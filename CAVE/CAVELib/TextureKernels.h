@@ -0,0 +1,55 @@
+// --------------------------------------------------------------------
+//  TextureKernels.h
+//
+//  Batch computation of texture coordinates for all vertices of the
+//  interrogated object, on packed arrays.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef TEXTUREKERNELS_H
+#define TEXTUREKERNELS_H
+
+/*! \file
+  The kernels read the points and normals as packed arrays with 3 floats
+  for every vertex, like the arrays of the vtkPolyData, and write 2 floats
+  for every vertex into a preallocated array, like the array of the
+  vtkTCoords. Nothing is allocated.
+
+  With SSE2 (__SSE2__, e.g. Performer on x86 Linux) four vertices are
+  computed at once in the SSE registers. Otherwise, as on MIPS, the
+  kernels are scalar loops without branches, which the compiler can
+  software pipeline. Big arrays are split into blocks, computed by a
+  number of threads.
+*/
+
+//! Set the number of threads used by the kernels
+/*!
+  The default is the number of processors online.
+*/
+void setTextureKernelThreads(int);
+//! Query the number of threads used by the kernels
+int  getTextureKernelThreads(void);
+
+//! Texture coordinates for the intersection of the normal lines with a light plane
+/*!
+  The plane is z = height. The texture coordinate of a vertex p with the
+  normal n is s = (p[axis] + lambda*n[axis] - lo)/width, with
+  lambda = (height - p[2])/n[2], and t = 0.5. For a normal parallel to
+  the plane s = -100 and t = 0, so the border color is used, like in
+  TopParallelLightCage::computeTextureCoordinates().
+*/
+void planeTextureCoordinates(const float *points, const float *normals, int n,
+                             int axis, float height, float lo, float width,
+                             float *tcoords);
+
+//! Texture coordinates for isophotes, s = lo + (1-lo)<n, direction> and t = 0.5
+/*!
+  Like LightVector::isophoteValue(), the normals have to be normalized.
+  The texture coordinates below lo are reserved for dark texels.
+*/
+void isophoteTextureCoordinates(const float *normals, int n,
+                                const float direction[3], float lo,
+                                float *tcoords);
+#endif
@@ -0,0 +1,86 @@
+// --------------------------------------------------------------------
+//  TextureMipmap.h
+//
+//  Mipmap pyramid for the intensity/alpha textures of the
+//  interrogation lines.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef TEXTUREMIPMAP_H
+#define TEXTUREMIPMAP_H
+
+#include <Performer/pr/pfTexture.h>
+
+//! A class computing the mipmap levels of a band texture
+/*!
+  The band textures of the light cages and the isophote ramp are
+  PFTEX_IA_8 textures: every texel is an unsigned short containing
+  intensity and alpha. TextureMipmap computes all levels down to
+  1 x 1 texel, every level is the 2 x 2 box filter of the level above,
+  rounded to the nearest value. One-dimensional textures (height 1)
+  are only filtered in s.
+
+  The filter works on 32 bit words containing two texels, copied from
+  the image with memcpy: the four bytes are split into two words with
+  16 bit lanes, so the sums of two rows are computed for two texels
+  and both channels with two additions.
+
+  The levels are attached to a pfTexture with ::attach(), the
+  minification filter is set to trilinear mipmapping.
+*/
+class TextureMipmap
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor computing the levels for an image
+   /*!
+     width and height have to be powers of 2. The image is level 0 and
+     is not copied. The other levels are allocated with pfMalloc in the
+     shared arena, they belong to the pfTexture after ::attach().
+   */
+   TextureMipmap(unsigned short *image, int width, int height);
+   //! Destructor. The images are not deleted.
+   ~TextureMipmap(void);
+
+   //! Query the number of levels, including level 0
+   int getNumberOfLevels(void);
+   //! Query the image of a level
+   unsigned short* getLevel(int);
+   //! Query the width of a level
+   int getWidth(int);
+   //! Query the height of a level
+   int getHeight(int);
+
+   //! Attach the levels to a texture and switch mipmapping on
+   void attach(pfTexture*);
+
+   //! Compute the mipmap levels for a texture
+   /*!
+     The image of the texture is used as level 0. It has to be a
+     PFTEX_IA_8 image with 2 components.
+   */
+   static void attachLevels(pfTexture*);
+
+   //! Box filter an image to the half size
+   /*!
+     The output has max(width/2, 1) x max(height/2, 1) texels.
+   */
+   static void downsample(const unsigned short *in, int width, int height,
+                          unsigned short *out);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The levels
+   unsigned short **levels;
+   //! Widths and heights of the levels
+   int *widths, *heights;
+   //! Number of levels
+   int numLevels;
+};
+#endif
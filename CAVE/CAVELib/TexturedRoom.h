@@ -154,6 +154,8 @@ virtual void addLightObjects(bool, bool, int, float, LightLine::Attenuation);
 virtual void addLightObjects(bool, int);
 virtual void addLightObjects(bool, int, LightLine::Attenuation);
 virtual void addLightObjects(bool, int, float, LightLine::Attenuation);
+// periodic stripes
+virtual void addPeriodicLightObjects(bool, int, float, LightLine::Attenuation);
 
 //! Build a light vector for working with isophotes
 /*!
@@ -192,6 +194,37 @@ int bitmapSize; // how big is the bitmap we use. Should be a power of 2!
 
 // Create the scene tree, without reading any objects, only structure
 virtual void createMasterScene(void);
+
+//! The texture map of the interrogated object, set by compute()
+/*!
+  With a TextureCache an unchanged texture map is not replaced, so it
+  is not uploaded again. The cache owns the texture then, it is not
+  deleted when a new one is set.
+*/
+pfTexture *texture;
+
+// Switch the 2D light plane texture of hlines on or off
+void usePlaneTexture(bool);
+
+//! The parallel cage, if its translations are applied as texture matrix
+/*!
+  NULL if the cage is not parallel or the interrogation lines do not
+  support the texture shear.
+*/
+TopParallelLightCage *shearCage;
+//! Parameters of the texture matrix (shift, lift, on)
+/*!
+  The draw process maps the texture coordinates of the interrogated
+  object with s' = s + shift + lift*t, t' = 0.5. Allocated in the
+  shared arena.
+*/
+float *textureTransform;
+
+// Switch the texture matrix for a parallel cage on or off
+void useTextureShear(bool);
+// Translate the cage. Without texture matrix the lines are recomputed,
+// if the last argument is true.
+void translateCage(float, float, float, bool);
 };
 
 #endif
@@ -0,0 +1,33 @@
+// --------------------------------------------------------------------
+//  ThreadBlocks.h
+//
+//  Split a range of work items into blocks, computed by a number of
+//  threads.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef THREADBLOCKS_H
+#define THREADBLOCKS_H
+
+/*! \file
+  Used by the texture computations: the rows of the LightPlaneTexture
+  and the vertices of the TextureKernels are split into one block for
+  every thread.
+*/
+
+//! Query the number of processors online, at least 1
+int getNumberOfProcessors(void);
+
+//! Compute the items [0, n) in blocks, one block for every thread
+/*!
+  The function is called as work(arg, first, last) for the items
+  [first, last) of a block. The blocks are computed by at most int
+  threads, the function returns after all blocks are done. With one
+  thread, or if a thread cannot be created, a block is computed by the
+  calling thread.
+*/
+void runThreadBlocks(int n, int threads,
+                     void (*work)(void *arg, int first, int last), void *arg);
+#endif
@@ -0,0 +1,193 @@
+// --------------------------------------------------------------------
+//  TiledMesh.h
+//
+//  A polygonal net split into spatial tiles, stored on disk and
+//  loaded on demand through a LRU cache with a memory budget.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef TILEDMESH_H
+#define TILEDMESH_H
+#include <list.h>
+#include <iostream.h>
+
+#include <vtkPolyData.h>
+#include <vtkPoints.h>
+#include <vtkNormals.h>
+#include <vtkCellArray.h>
+
+#include "VertexClusters.h"
+
+//! A class representing a polygonal net stored as spatial tiles
+/*!
+  Objects bigger than the main memory can not be interrogated as one
+  vtkPolyData. TiledMesh splits the polygonal net once into a regular
+  grid of n x n x n tiles. Every cell of the net is assigned to the tile
+  containing its centroid; the points and normals of the cell are copied
+  into the tile, so vertices on tile borders exist in more than one tile.
+  The tiles are written as binary VTK files into a directory, together
+  with an index file "tiles.idx" containing the bounding box and the
+  memory footprint of every tile.
+
+  A net in a VTK file is split without reading it into memory: the file
+  is read with a PolyDataStream, the points and normals are kept in
+  scratch files mapped into memory, and every cell is appended to the
+  bucket file of its tile in one pass. Then the tiles are built one
+  after the other from their buckets. A simplified version of the net,
+  "object.vtk", is written together with the tiles by VertexClusters,
+  to be shown instead of the whole net.
+
+  While interrogating the tiles are read with TiledMesh::getTile(). The
+  tiles in memory are kept in a LRU cache; if loading a tile would exceed
+  the memory budget, the least recently used tiles are deleted first.
+
+  Contouring is done triangle by triangle, so contouring the tiles one
+  after the other gives the same interrogation lines as contouring the
+  whole net.
+*/
+class TiledMesh
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor opening an existing set of tiles
+   /*!
+     The index file "tiles.idx" is read from the directory. No tile is
+     loaded. The memory budget is given in kilobytes.
+   */
+   TiledMesh(const char *directory, int budget);
+   //! Constructor splitting a polygonal net into tiles
+   /*!
+     The polygonal net is split into n x n x n tiles, which are written
+     into the directory. The directory is created, if it does not exist.
+     The polygonal net has to contain point normals. No tile is kept in
+     memory. The simplified net is clustered in a grid with res x res x res
+     cells. The memory budget is given in kilobytes.
+   */
+   TiledMesh(vtkPolyData *mesh, const char *directory, int n, int res, int budget);
+   //! Constructor splitting a polygonal net in a VTK file into tiles
+   /*!
+     Like the constructor above, but the net is streamed from the file
+     and never kept in memory as a whole. If the file contains no point
+     normals, the normals are averaged from the triangles.
+   */
+   TiledMesh(const char *file, const char *directory, int n, int res, int budget);
+   //! Destructor, deleting all tiles in memory
+   ~TiledMesh(void);
+
+   //! Query the number of tiles
+   int getNumberOfTiles(void);
+
+   //! Query the file name of the simplified net
+   /*!
+     false is given back, if the file does not exist, e.g. for tiles
+     written by an older version.
+   */
+   bool getObjectFileName(char*);
+
+   //! Query a tile
+   /*!
+     If the tile is not in memory, it is read from disk. NULL is given back
+     for an empty tile. The pointer is only valid until the next call of
+     TiledMesh::getTile(), because the tile can be deleted from the cache.
+     Use vtkPolyData::CopyStructure() to keep it longer.
+   */
+   vtkPolyData* getTile(int);
+
+   //! Query the bounding box of a tile (xmin, xmax, ymin, ymax, zmin, zmax)
+   void getTileBounds(int, float b[6]);
+   //! Query the bounding box of the whole net (xmin, xmax, ymin, ymax, zmin, zmax)
+   void getBoundingBox(float b[6]);
+
+   //! Set the memory budget for the tiles in memory in kilobytes
+   void setMemoryBudget(int);
+   //! Query the memory budget in kilobytes
+   int  getMemoryBudget(void);
+   //! Query the memory used by the tiles in memory in kilobytes
+   int  getMemoryInUse(void);
+   //! Query the maximum of memory used by the tiles since construction in kilobytes
+   int  getPeakMemory(void);
+   //! Query how often a tile was read from disk
+   int  getNumberOfLoads(void);
+
+   //! Delete all tiles in memory
+   void flush(void);
+
+   //! Print the cache statistics
+   void printStatistics(ostream&);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Directory containing the tiles and the index file
+   char *directory;
+   //! Number of tiles
+   int numTiles;
+   //! Bounding box of the whole net
+   float box[6];
+   //! Bounding boxes of the tiles, 6 floats for every tile
+   float *tileBounds;
+   //! Number of points in every tile; empty tiles are not written
+   int *tilePoints;
+   //! Memory footprint of every tile in kilobytes
+   int *tileSize;
+   //! The tiles in memory, NULL if a tile is not loaded
+   vtkPolyData **resident;
+   //! Tiles in memory, the most recently used tile is the first element
+   list<int> lru;
+   //! Memory budget in kilobytes
+   int budget;
+   //! Memory used by the tiles in memory in kilobytes
+   int inUse;
+   //! Maximum of inUse
+   int peak;
+   //! Number of tiles read from disk
+   int loads;
+   //! Number of tiles in every direction
+   int resolution;
+   //! Extent of the bounding box in every direction
+   float extent[3];
+   //! Buffers of the cells of every tile while splitting a file
+   int **bucket;
+   //! Number of integers in every buffer
+   int *bucketFill;
+   //! Size of a buffer
+   static const int bucketSize;
+
+   // compound function to set the members to default values
+   void init(const char*, int);
+   // allocate the arrays for n x n x n tiles
+   void allocate(int);
+   // the tile of a point
+   int  tileOf(const float*, int);
+   // split a polygonal net into n x n x n tiles and write them
+   void split(vtkPolyData*, int, int);
+   // split a polygonal net in a file into n x n x n tiles and write them
+   void splitFile(const char*, int, int);
+   // build the tiles from the bucket files of splitFile()
+   void buildTiles(float*, float*, VertexClusters*);
+   // write a tile, and add it to the simplified net
+   void writeTile(int, vtkPoints*, vtkNormals*, vtkCellArray*, vtkCellArray*,
+                  VertexClusters*);
+   // write the simplified net
+   void writeObject(VertexClusters*);
+   // append a cell to the bucket of a tile
+   void appendBucket(int, int*, int);
+   // write the buffer of a bucket, or the cells given, into its file
+   void flushBucket(int, int*, int);
+   // map a scratch file for 3 floats per point
+   float* mapScratch(const char*, int, int&);
+   void unmapScratch(const char*, float*, int, int);
+   // r/w the index file
+   void writeIndex(void);
+   void readIndex(void);
+   // delete the least recently used tile
+   void evict(void);
+   // file name of a tile
+   void tileFileName(int, char*);
+};
+#endif
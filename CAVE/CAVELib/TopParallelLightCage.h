@@ -19,6 +19,7 @@
 #include <vtkRenderer.h>
 
 #include "LightCage.h"
+#include "TextureKernels.h"
 
 //! A class representing a light cage with parallel lines in a plane
 /*!
@@ -128,6 +129,17 @@ public:
 
    // compute a 1D texture coordinate for a given point and normal.
    virtual float* computeTextureCoordinates(float*, float*);
+   //! Compute the 1D texture coordinates for n vertices
+   /*!
+     The intersection with the light plane is computed with
+     planeTextureCoordinates(), without allocating memory.
+   */
+   virtual void computeTextureCoordinates(const float *points, const float *normals,
+                                          int n, float *tcoords)
+   {
+      planeTextureCoordinates(points, normals, n, lui, BBox[5] + zs,
+                              BBox[2*lui], BBox[2*lui+1] - BBox[2*lui], tcoords);
+   }
 
    //! Transform a vector from texture space to the bounding box
    pfVec3 transformVectorToBBox(pfVec3 vector);
@@ -155,6 +167,26 @@ public:
    //! Query the normal.
    virtual void getCageNormal(float, float v[3]);
 
+   //! Query the shear of the texture coordinate for a normal
+   /*!
+     The texture coordinate of a vertex is the intersection of the
+     normal line and the light plane. Moving the light plane by dz
+     changes the texture coordinate by dz times the shear, moving the
+     cage in the plane shifts the texture coordinate of all vertices by
+     the same amount, see computeTextureShift(). Both are exact, the
+     texture map does not change.
+   */
+   inline float computeTextureShear(float n[3])
+   {
+      if ((n[2] < 1.0E-8f) && (n[2] > -1.0E-8f)) return 0.0f;
+      return n[lui]/(n[2]*(BBox[2*lui+1] - BBox[2*lui]));
+   }
+   //! Query the shift of the texture coordinate for a translation in the plane
+   inline float computeTextureShift(float x, float y)
+   {
+      return -((lui == 0) ? x : y)/(BBox[2*lui+1] - BBox[2*lui]);
+   }
+
    //! Translate the cage lines
    virtual void translate(float, float, float);
    //! Rotate the cage lines
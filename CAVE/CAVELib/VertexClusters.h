@@ -0,0 +1,93 @@
+// --------------------------------------------------------------------
+//  VertexClusters.h
+//
+//  Simplify a polygonal net by vertex clustering, the net is given
+//  piece by piece.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef VERTEXCLUSTERS_H
+#define VERTEXCLUSTERS_H
+
+#include <vtkPolyData.h>
+
+//! A class simplifying a polygonal net given in pieces
+/*!
+  The vertices are clustered in a uniform grid over a bounding box
+  given in advance. Every cluster is replaced by the mean of its
+  vertices, its normal is the average of the vertex normals. Triangles
+  with two vertices in the same cluster are removed.
+
+  Unlike MeshHierarchy, which needs the whole net in memory, the pieces
+  are added one after the other, e.g. the tiles of a TiledMesh. Only
+  the occupied clusters and the remaining triangles are kept, so the
+  memory depends on the resolution of the grid, not on the size of
+  the net.
+*/
+class VertexClusters
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor for a grid with res x res x res cells in the box
+   /*!
+     The box is given as (xmin, xmax, ymin, ymax, zmin, zmax).
+   */
+   VertexClusters(const float box[6], int res);
+   //! Destructor
+   ~VertexClusters(void);
+
+   //! Add the polygons and strips of a piece of the net
+   /*!
+     The piece has to contain point normals.
+   */
+   void add(vtkPolyData*);
+
+   //! Build the simplified net
+   /*!
+     The polygonal data is new, the caller has to delete it.
+   */
+   vtkPolyData* getPolyData(void);
+   //! Query the number of triangles of the simplified net
+   int getNumberOfTriangles(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Bounding box of the grid
+   float box[6];
+   //! Size of a grid cell
+   float size[3];
+   //! Resolution of the grid
+   int res;
+   //! Hash table of the occupied grid cells
+   unsigned long long *tableKeys;
+   //! Cluster of every entry of the hash table
+   int *tableCluster;
+   //! Size of the hash table, a power of 2
+   int tableSize;
+   //! Sum of the positions and the normals of every cluster, 6 doubles
+   double *sum;
+   //! Number of vertices in every cluster
+   int *count;
+   //! Number of clusters
+   int numClusters;
+   //! The remaining triangles, 3 clusters each
+   int *tris;
+   //! Number of remaining triangles
+   int numTris;
+   //! Capacity of the arrays for clusters and triangles
+   int clusterCapacity, triCapacity;
+
+   // find or insert the cluster of a point
+   int cluster(const float p[3]);
+   // insert a triangle, if it has 3 different clusters
+   void addTriangle(int, int, int);
+   // double the size of the hash table
+   void rehash(void);
+};
+#endif
@@ -0,0 +1,99 @@
+// --------------------------------------------------------------------
+//  LightForms.h
+//
+//  The light forms of the light cylinders, their integrals and the
+//  box filter, shared by the CAVELib and the VRJuggler version.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef LIGHTFORMS_H
+#define LIGHTFORMS_H
+
+#include <math.h>
+
+// LightLine.h of the version including this header
+#include "LightLine.h"
+
+/*! \file
+  The light form g(x) gives the luminance at the distance x to the
+  center of a light cylinder, relative to the radius. It is 0 for
+  |x| > 1. Both versions of LightLine define the same attenuations.
+*/
+
+//! Luminance of the light form at the distance x, relative to the radius
+inline double lightForm(double x, LightLine::Attenuation form)
+{
+   double value = 0.0;
+
+   x = fabs(x);
+   if (x > 1.0) return 0.0;
+
+   switch (form) {
+           case LightLine::Linear:
+                       value = 1.0 - x;
+                       break;
+           case LightLine::Quadratic:
+                       value = 1.0 - x*x;
+                       break;
+           case LightLine::Polynomial:
+                       value = 1.0 - x*x*(3.0 - 2.0*x);
+                       break;
+           case LightLine::Constant:
+                       value = 1.0;
+                       break;
+           default:
+                       break;
+   }
+   return value;
+}
+
+//! Integral of the light form from 0 to t, relative to the radius
+/*!
+  The antiderivatives of the light forms g(x), 0 <= x <= 1:
+  \verbatim
+    Constant    g = 1                 G = x
+    Linear      g = 1 - x             G = x - x^2/2
+    Quadratic   g = 1 - x^2           G = x - x^3/3
+    Polynomial  g = 1 - x^2(3 - 2x)   G = x - x^3 + x^4/2
+  \endverbatim
+  The integral is odd in t and constant for |t| > 1.
+*/
+inline double lightFormIntegral(double t, LightLine::Attenuation form)
+{
+   double x = fabs(t), value = 0.0;
+
+   if (x > 1.0) x = 1.0;
+
+   switch (form) {
+           case LightLine::Linear:
+                       value = x - 0.5*x*x;
+                       break;
+           case LightLine::Quadratic:
+                       value = x - x*x*x/3.0;
+                       break;
+           case LightLine::Polynomial:
+                       value = x - x*x*x + 0.5*x*x*x*x;
+                       break;
+           case LightLine::Constant:
+                       value = x;
+                       break;
+           default:
+                       break;
+   }
+   return (t < 0.0) ? -value : value;
+}
+
+//! Mean luminance over the signed distances [a, b], relative to the radius
+/*!
+  The exact box filter of the light form over a texel covering the
+  distances a to b. A texel smaller than the precision is point sampled.
+*/
+inline double lightFormBoxFilter(double a, double b, LightLine::Attenuation form)
+{
+   if (fabs(b-a) < 1.0E-6) return lightForm(0.5*(a+b), form);
+
+   return (lightFormIntegral(b, form) - lightFormIntegral(a, form))/(b-a);
+}
+#endif
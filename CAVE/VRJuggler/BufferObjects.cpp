@@ -0,0 +1,117 @@
+// --------------------------------------------------------------------
+//  BufferObjects.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "BufferObjects.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// The ARB names have the same signatures
+typedef void (APIENTRY *GenBuffersProc)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteBuffersProc)(GLsizei, const GLuint*);
+typedef void (APIENTRY *BindBufferProc)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataProc)(GLenum, ptrdiff_t, const void*, GLenum);
+typedef void (APIENTRY *BufferSubDataProc)(GLenum, ptrdiff_t, ptrdiff_t, const void*);
+
+static GenBuffersProc    genBuffersProc    = 0;
+static DeleteBuffersProc deleteBuffersProc = 0;
+static BindBufferProc    bindBufferProc    = 0;
+static BufferDataProc    bufferDataProc    = 0;
+static BufferSubDataProc bufferSubDataProc = 0;
+
+static bool queried = false, available = false;
+
+static void* procAddress(const char *name)
+{
+#ifdef _WIN32
+   return (void*) wglGetProcAddress(name);
+#else
+   // the GL library of the context, libGL or libOSMesa, is linked
+   return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
+static bool loadProcs(const char *suffix)
+{
+   char name[32];
+
+   strcpy(name, "glGenBuffers");    strcat(name, suffix);
+   genBuffersProc = (GenBuffersProc) procAddress(name);
+   strcpy(name, "glDeleteBuffers"); strcat(name, suffix);
+   deleteBuffersProc = (DeleteBuffersProc) procAddress(name);
+   strcpy(name, "glBindBuffer");    strcat(name, suffix);
+   bindBufferProc = (BindBufferProc) procAddress(name);
+   strcpy(name, "glBufferData");    strcat(name, suffix);
+   bufferDataProc = (BufferDataProc) procAddress(name);
+   strcpy(name, "glBufferSubData"); strcat(name, suffix);
+   bufferSubDataProc = (BufferSubDataProc) procAddress(name);
+
+   return genBuffersProc && deleteBuffersProc && bindBufferProc &&
+          bufferDataProc && bufferSubDataProc;
+}
+
+bool hasBufferObjects(void)
+{
+   const char *version, *extensions;
+   int major, minor = 0;
+
+   if (queried) return available;
+
+   version = (const char*) glGetString(GL_VERSION);
+   extensions = (const char*) glGetString(GL_EXTENSIONS);
+   // no context yet: ask again with the next call
+   if (version == 0) return false;
+   queried = true;
+
+   major = atoi(version);
+   if (strchr(version, '.') != 0) minor = atoi(strchr(version, '.') + 1);
+
+   if (major > 1 || (major == 1 && minor >= 5))
+      available = loadProcs("");
+   if (!available && extensions != 0 &&
+       strstr(extensions, "GL_ARB_vertex_buffer_object") != 0)
+      available = loadProcs("ARB");
+
+   return available;
+}
+
+void genBuffers(GLsizei n, GLuint *buffers)
+{
+   genBuffersProc(n, buffers);
+}
+
+void deleteBuffers(GLsizei n, const GLuint *buffers)
+{
+   deleteBuffersProc(n, buffers);
+}
+
+void bindBuffer(GLenum target, GLuint buffer)
+{
+   bindBufferProc(target, buffer);
+}
+
+void bufferData(GLenum target, ptrdiff_t size, const void *data, GLenum usage)
+{
+   bufferDataProc(target, size, data, usage);
+}
+
+void bufferSubData(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void *data)
+{
+   bufferSubDataProc(target, offset, size, data);
+}
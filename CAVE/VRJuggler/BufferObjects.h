@@ -0,0 +1,48 @@
+// --------------------------------------------------------------------
+//  BufferObjects.h
+//
+//  The entry points of the OpenGL vertex buffer objects, queried at
+//  run time.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef BUFFEROBJECTS
+#define BUFFEROBJECTS
+
+#include <stddef.h>
+#include <GL/gl.h>
+
+// OpenGL 1.5, not in every gl.h
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER          0x8892
+#define GL_ELEMENT_ARRAY_BUFFER  0x8893
+#define GL_STREAM_DRAW           0x88E0
+#define GL_STATIC_DRAW           0x88E4
+#define GL_DYNAMIC_DRAW          0x88E8
+#endif
+
+//! Are vertex buffer objects available in the current context?
+/*!
+  With OpenGL 1.5 the core entry points are used, otherwise the ARB
+  entry points of GL_ARB_vertex_buffer_object. The entry points are
+  queried with the first call, a valid GL context is needed. On
+  Windows they are valid for the context current at the first call.
+
+  Without buffer objects the classes using them fall back to client
+  side arrays, like in OpenGL 1.1.
+*/
+bool hasBufferObjects(void);
+
+//! glGenBuffers
+void genBuffers(GLsizei n, GLuint *buffers);
+//! glDeleteBuffers
+void deleteBuffers(GLsizei n, const GLuint *buffers);
+//! glBindBuffer
+void bindBuffer(GLenum target, GLuint buffer);
+//! glBufferData
+void bufferData(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+//! glBufferSubData
+void bufferSubData(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void *data);
+#endif
@@ -0,0 +1,353 @@
+// --------------------------------------------------------------------
+//  CageRenderer.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "CageRenderer.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "BufferObjects.h"
+
+static inline GLubyte colorByte(float c)
+{
+   if (c <= 0.0f) return 0;
+   if (c >= 1.0f) return 255;
+   return (GLubyte) (255.0f*c + 0.5f);
+}
+
+CageRenderer::CageRenderer(LightCage *c, LightVector *light)
+{
+   cage = c;
+   lightVector = light;
+   cageVisible = true;
+   slices = 20;
+
+   vectorVertices = lineVertices = triangleVertices = 0;
+   cageRevision = 0;
+   for (int i=0; i<10; i++) vectorState[i] = 0.0f;
+   loaded = false;
+
+   initialized = false;
+   buffer = 0;
+   bufferVertices = 0;
+
+   drawCalls = uploads = 0;
+   wide.setWidth(0.0f);
+}
+
+CageRenderer::~CageRenderer(void)
+{
+   if (buffer != 0) deleteBuffers(1, &buffer);
+}
+
+void CageRenderer::setCage(LightCage *c)
+{
+   cage = c;
+   cageRevision = 0;
+}
+
+void CageRenderer::setLightVector(LightVector *light)
+{
+   lightVector = light;
+   cageRevision = 0;
+}
+
+void CageRenderer::showCage(bool show)
+{
+   cageVisible = show;
+}
+
+bool CageRenderer::getShowCage(void)
+{
+   return cageVisible;
+}
+
+void CageRenderer::setSlices(int s)
+{
+   if (s < 3) s = 3;
+   if (s != slices) cageRevision = 0;
+   slices = s;
+}
+
+int CageRenderer::getSlices(void)
+{
+   return slices;
+}
+
+void CageRenderer::setLineWidth(float w)
+{
+   wide.setWidth(w);
+}
+
+float CageRenderer::getLineWidth(void)
+{
+   return wide.getWidth();
+}
+
+bool CageRenderer::update(void)
+{
+   float state[10];
+   bool changed;
+
+   if (!initialized) initialize();
+
+   vectorParameters(state);
+   changed = (cageRevision == 0) ||
+             (cage != 0 && cage->getRevision() != cageRevision) ||
+             (memcmp(state, vectorState, sizeof(state)) != 0);
+
+   if (changed) {
+      build();
+      memcpy(vectorState, state, sizeof(state));
+      cageRevision = (cage != 0) ? cage->getRevision() : 1;
+      loaded = false;
+   }
+   if (!loaded && buffer != 0) upload();
+   loaded = true;
+
+   return changed;
+}
+
+// The lines of the vector and of the cage are contiguous, a hidden
+// cage only shortens the range of the first draw call.
+void CageRenderer::draw(void)
+{
+   const GLubyte *base;
+   int lines;
+
+   update();
+   if (vertices.empty()) return;
+
+   glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+   if (buffer != 0) {
+      bindBuffer(GL_ARRAY_BUFFER, buffer);
+      base = 0;
+   }
+   else
+      base = (const GLubyte*) &vertices[0];
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_NORMAL_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(3, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, position));
+   glNormalPointer(GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, normal));
+   glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + offsetof(Vertex, color));
+
+   lines = vectorVertices + (cageVisible ? lineVertices : 0);
+   if (lines > 0 && wide.getWidth() <= 0.0f) {
+      glDrawArrays(GL_LINES, 0, lines);
+      drawCalls++;
+   }
+   if (cageVisible && triangleVertices > 0) {
+      glDrawArrays(GL_TRIANGLES, vectorVertices + lineVertices, triangleVertices);
+      drawCalls++;
+   }
+
+   if (buffer != 0) bindBuffer(GL_ARRAY_BUFFER, 0);
+   glPopClientAttrib();
+
+   if (lines > 0 && wide.getWidth() > 0.0f) drawWideLines(lines);
+}
+
+bool CageRenderer::usesBufferObject(void)
+{
+   return buffer != 0;
+}
+
+int CageRenderer::getNumberOfVertices(void)
+{
+   return vertices.size();
+}
+
+unsigned int CageRenderer::getDrawCalls(void)
+{
+   return drawCalls;
+}
+
+unsigned int CageRenderer::getUploads(void)
+{
+   return uploads;
+}
+
+void CageRenderer::resetStatistics(void)
+{
+   drawCalls = uploads = 0;
+}
+
+//
+// private
+//
+
+void CageRenderer::initialize(void)
+{
+   // no current context: ask again with the next update
+   if (glGetString(GL_VERSION) == 0) return;
+   initialized = true;
+   if (hasBufferObjects()) genBuffers(1, &buffer);
+}
+
+void CageRenderer::build(void)
+{
+   float p[3], d[3], q[3], color[3], length;
+   const float *points, *directions, *radii;
+   int i, n;
+
+   vertices.clear();
+   vectorVertices = lineVertices = triangleVertices = 0;
+
+   // the light vector
+   if (lightVector != 0) {
+      lightVector->getRenderOrigin(p);
+      lightVector->getDirection(d);
+      lightVector->getColor(color);
+      length = lightVector->getLength();
+      for (i=0; i<3; i++) q[i] = p[i] + length*d[i];
+      addLine(p, q, color);
+      vectorVertices = 2;
+   }
+   if (cage == 0 || cage->empty()) return;
+
+   // the lines of the cage, then the cylinders
+   n = cage->size();
+   points = cage->getPoints();
+   directions = cage->getDirections();
+   radii = cage->getRadii();
+
+   for (i=0; i<n; i++) {
+       if (cage->getCylinder(i)) continue;
+       length = cage->getLength(i);
+       q[0] = points[3*i]   + length*directions[3*i];
+       q[1] = points[3*i+1] + length*directions[3*i+1];
+       q[2] = points[3*i+2] + length*directions[3*i+2];
+       addLine(points + 3*i, q, cage->getLineColor(i));
+       lineVertices += 2;
+   }
+   for (i=0; i<n; i++) {
+       if (!cage->getCylinder(i)) continue;
+       addCylinder(points + 3*i, directions + 3*i, cage->getLength(i),
+                   radii[i], cage->getLineColor(i));
+       triangleVertices += 6*slices;
+   }
+}
+
+// If the number of vertices did not change, for example after a
+// translation or rotation of the cage, the buffer is written in place.
+// It is rewritten with every change of the cage, so it is a
+// GL_DYNAMIC_DRAW buffer.
+void CageRenderer::upload(void)
+{
+   int n = vertices.size();
+
+   bindBuffer(GL_ARRAY_BUFFER, buffer);
+   if (n != bufferVertices) {
+      bufferData(GL_ARRAY_BUFFER, n*sizeof(Vertex), n ? &vertices[0] : 0, GL_DYNAMIC_DRAW);
+      bufferVertices = n;
+   }
+   else if (n > 0)
+      bufferSubData(GL_ARRAY_BUFFER, 0, n*sizeof(Vertex), &vertices[0]);
+   bindBuffer(GL_ARRAY_BUFFER, 0);
+   uploads++;
+}
+
+// The quads are built from the client copy of the vertices
+void CageRenderer::drawWideLines(int n)
+{
+   int i;
+
+   wide.begin();
+   for (i=0; i<n; i+=2) {
+       wide.setColor(vertices[i].color);
+       wide.addSegment(vertices[i].position, vertices[i+1].position);
+   }
+   wide.end();
+   drawCalls++;
+}
+
+void CageRenderer::addLine(const float p[3], const float q[3], const float color[3])
+{
+   Vertex v;
+   int i;
+
+   for (i=0; i<3; i++) {
+       v.normal[i] = 0.0f;
+       v.color[i] = colorByte(color[i]);
+   }
+   v.normal[2] = 1.0f;
+   v.color[3] = 255;
+
+   for (i=0; i<3; i++) v.position[i] = p[i];
+   vertices.push_back(v);
+   for (i=0; i<3; i++) v.position[i] = q[i];
+   vertices.push_back(v);
+}
+
+// The cylinder starts in p and has the axis d, like the lines. Two
+// triangles for every facet, the normals are radial.
+void CageRenderer::addCylinder(const float p[3], const float d[3], float length,
+                               float radius, const float color[3])
+{
+   float axis[3], u[3], w[3], len, c, s;
+   Vertex corner[4];
+   int i, j, k;
+
+   len = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+   if (len == 0.0f) return;
+   for (i=0; i<3; i++) axis[i] = d[i]/len;
+
+   // u orthogonal to the axis, w = axis x u
+   if (fabs(axis[0]) < 0.9f) {
+      u[0] = 0.0f; u[1] = axis[2]; u[2] = -axis[1];
+   }
+   else {
+      u[0] = -axis[2]; u[1] = 0.0f; u[2] = axis[0];
+   }
+   len = sqrt(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+   for (i=0; i<3; i++) u[i] /= len;
+   w[0] = axis[1]*u[2] - axis[2]*u[1];
+   w[1] = axis[2]*u[0] - axis[0]*u[2];
+   w[2] = axis[0]*u[1] - axis[1]*u[0];
+
+   for (k=0; k<4; k++) {
+       for (i=0; i<3; i++) corner[k].color[i] = colorByte(color[i]);
+       corner[k].color[3] = 255;
+   }
+
+   for (j=0; j<slices; j++) {
+       // corners 0, 1 at the start, 2, 3 at the end of the cylinder
+       for (k=0; k<2; k++) {
+           c = cos(2.0*M_PI*(j+k)/slices);
+           s = sin(2.0*M_PI*(j+k)/slices);
+           for (i=0; i<3; i++) {
+               corner[k].normal[i] = c*u[i] + s*w[i];
+               corner[k].position[i] = p[i] + radius*corner[k].normal[i];
+               corner[k+2].normal[i] = corner[k].normal[i];
+               corner[k+2].position[i] = corner[k].position[i] + length*axis[i];
+           }
+       }
+       vertices.push_back(corner[0]);
+       vertices.push_back(corner[1]);
+       vertices.push_back(corner[3]);
+       vertices.push_back(corner[0]);
+       vertices.push_back(corner[3]);
+       vertices.push_back(corner[2]);
+   }
+}
+
+void CageRenderer::vectorParameters(float s[10])
+{
+   int i;
+
+   for (i=0; i<10; i++) s[i] = 0.0f;
+   if (lightVector == 0) return;
+
+   lightVector->getRenderOrigin(s);
+   lightVector->getDirection(s+3);
+   s[6] = lightVector->getLength();
+   lightVector->getColor(s+7);
+}
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------
+//  CageRenderer.h
+//
+//  Render a light cage and a light vector from one vertex buffer.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CAGERENDERER
+#define CAGERENDERER
+
+#include <vector>
+#include <GL/gl.h>
+
+#include "LightCage.h"
+#include "LightVector.h"
+#include "WideLines.h"
+
+using namespace std;
+
+//! Render a light cage and a light vector with vertex arrays
+/*!
+  LightCage::draw() and LightVector::draw() send every vertex in
+  immediate mode, cylinders are built with a GLU quadric in every
+  call, and the display lists of LightCage::createList() have to be
+  compiled again after every change of the cage.
+
+  This class keeps the geometry of the light vector, the cage lines
+  and the cylinder meshes in one vertex array: position, normal and
+  color for every vertex. The lines come first, drawn as GL_LINES, the
+  cylinders follow, drawn as GL_TRIANGLES. Without cylinders a frame
+  is one draw call. The array is built again by ::update() only if the
+  revision of the cage or the light vector has changed, if the number
+  of vertices is the same the buffer is written in place.
+
+  With OpenGL 1.5 or GL_ARB_vertex_buffer_object the array is stored
+  in a vertex buffer object, see hasBufferObjects(). Otherwise the client side array is used with glDrawArrays(), like in
+  OpenGL 1.1; this works with every Mesa software renderer.
+
+  With ::setLineWidth() the lines are drawn as \link WideLines \endlink,
+  quads built for the view in every frame, instead of GL_LINES.
+
+  The number of draw calls and of buffer uploads are counted, so the
+  cost of a frame can be measured without a window.
+*/
+class CageRenderer
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor for a cage and an optional light vector
+   CageRenderer(LightCage *cage, LightVector *light = 0);
+   //! Destructor, the buffer object is deleted
+   ~CageRenderer(void);
+
+   //! Set the light cage, 0 for no cage
+   void setCage(LightCage *);
+   //! Set the light vector, 0 for no vector
+   void setLightVector(LightVector *);
+   //! Render the cage, the default is true
+   void showCage(bool);
+   //! Is the cage rendered?
+   bool getShowCage(void);
+
+   //! Set the number of facets of the cylinders, the default is 20
+   void setSlices(int);
+   //! Query the number of facets of the cylinders
+   int  getSlices(void);
+   //! Set the width of the lines in pixels, 0 for GL_LINES, the default
+   void  setLineWidth(float);
+   //! Query the width of the lines in pixels, 0 for GL_LINES
+   float getLineWidth(void);
+
+   //! Build the vertices again, if the cage or the light vector have changed
+   /*!
+     The light vector has no revision, its origin, direction, length
+     and color are compared with the values of the last update. The
+     result is true, if the vertices were built again. A valid GL
+     context is needed.
+   */
+   bool update(void);
+   //! Render the cage and the light vector
+   /*!
+     ::update() is called first. The client state of the vertex arrays
+     is saved and restored, lighting is not changed.
+   */
+   void draw(void);
+
+   //! Is a vertex buffer object used?
+   bool usesBufferObject(void);
+   //! Query the number of vertices
+   int  getNumberOfVertices(void);
+   //! Query the number of draw calls since the last ::resetStatistics()
+   unsigned int getDrawCalls(void);
+   //! Query the number of buffer uploads since the last ::resetStatistics()
+   unsigned int getUploads(void);
+   //! Set the counters to 0
+   void resetStatistics(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! One vertex, interleaved
+   struct Vertex
+   {
+      float position[3];
+      float normal[3];
+      GLubyte color[4];
+   };
+
+   //! The light cage
+   LightCage *cage;
+   //! The light vector
+   LightVector *lightVector;
+   //! Render the cage?
+   bool cageVisible;
+   //! Number of facets of the cylinders
+   int slices;
+
+   //! The vertices: vector, cage lines, cylinder triangles
+   vector<Vertex> vertices;
+   //! Number of vertices of the light vector, 0 or 2
+   int vectorVertices;
+   //! Number of vertices of the cage lines
+   int lineVertices;
+   //! Number of vertices of the cylinder triangles
+   int triangleVertices;
+
+   //! Revision of the cage the vertices are built for, 0 if not built
+   unsigned int cageRevision;
+   //! Light vector the vertices are built for: origin, direction, length, color
+   float vectorState[10];
+   //! Does the buffer contain the vertices?
+   bool loaded;
+
+   //! Has the GL been queried for vertex buffer objects?
+   bool initialized;
+   //! The buffer object, 0 for client side arrays
+   GLuint buffer;
+   //! Number of vertices the buffer is allocated for
+   int bufferVertices;
+   //! Quads for the wide lines, width 0 for GL_LINES
+   WideLines wide;
+
+   //! Counters
+   unsigned int drawCalls, uploads;
+
+   //! Create the buffer object, if buffer objects are available
+   void initialize(void);
+   //! Build the vertices from the cage and the light vector
+   void build(void);
+   //! Load the vertices into the buffer object
+   void upload(void);
+   //! Draw the first n vertices, the lines, as quads
+   void drawWideLines(int n);
+   //! Add the vertices of a line
+   void addLine(const float p[3], const float q[3], const float color[3]);
+   //! Add the triangles of a cylinder
+   void addCylinder(const float p[3], const float d[3], float length,
+                    float radius, const float color[3]);
+   //! Read the state of the light vector into s
+   void vectorParameters(float s[10]);
+};
+#endif
@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------
+//  CameraPath.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "CameraPath.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <GL/gl.h>
+
+CameraPath::CameraPath(void)
+{
+}
+
+bool CameraPath::read(const char *filename)
+{
+   FILE *file = fopen(filename, "r");
+   char line[256];
+   float v[6];
+
+   if (file == NULL) return false;
+
+   keys.clear();
+   while (fgets(line, sizeof(line), file) != NULL) {
+       if (line[0] == '#') continue;
+       if (sscanf(line, "%f %f %f %f %f %f",
+                  &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == 6)
+          addKey(v, v+3);
+   }
+   fclose(file);
+
+   return !keys.empty();
+}
+
+void CameraPath::orbit(const float box[6], int n)
+{
+   float center[3], eye[3], diagonal, a;
+   int i;
+
+   if (n < 2) n = 2;
+   for (i=0; i<3; i++) center[i] = 0.5f*(box[2*i]+box[2*i+1]);
+   diagonal = sqrt((box[1]-box[0])*(box[1]-box[0]) +
+                   (box[3]-box[2])*(box[3]-box[2]) +
+                   (box[5]-box[4])*(box[5]-box[4]));
+
+   keys.clear();
+   for (i=0; i<n; i++) {
+       a = 2.0*M_PI*i/(n-1);
+       eye[0] = center[0] + diagonal*sin(a);
+       eye[1] = center[1] + 0.5f*diagonal;
+       eye[2] = center[2] + diagonal*cos(a);
+       addKey(eye, center);
+   }
+}
+
+void CameraPath::addKey(const float eye[3], const float center[3])
+{
+   keys.insert(keys.end(), eye, eye+3);
+   keys.insert(keys.end(), center, center+3);
+}
+
+int CameraPath::getNumberOfKeys(void)
+{
+   return keys.size()/6;
+}
+
+void CameraPath::getView(float t, float eye[3], float center[3])
+{
+   int i, k, n = getNumberOfKeys();
+   float s;
+   const float *a, *b;
+
+   if (n == 0) {
+      for (i=0; i<3; i++) eye[i] = center[i] = 0.0f;
+      eye[2] = 1.0f;
+      return;
+   }
+
+   if (t < 0.0f) t = 0.0f;
+   if (t > 1.0f) t = 1.0f;
+   // segment k from key k to key k+1
+   s = t*(n-1);
+   k = (int) s;
+   if (k >= n-1) k = (n > 1) ? n-2 : 0;
+   s -= k;
+   a = &keys[6*k];
+   b = (n > 1) ? &keys[6*(k+1)] : a;
+
+   for (i=0; i<3; i++) {
+       eye[i]    = (1.0f-s)*a[i]   + s*b[i];
+       center[i] = (1.0f-s)*a[i+3] + s*b[i+3];
+   }
+}
+
+void CameraPath::apply(float t)
+{
+   float eye[3], center[3], f[3], s[3], u[3], len;
+   GLfloat m[16];
+   int i;
+
+   getView(t, eye, center);
+
+   for (i=0; i<3; i++) f[i] = center[i] - eye[i];
+   len = sqrt(f[0]*f[0] + f[1]*f[1] + f[2]*f[2]);
+   if (len == 0.0f) return;
+   for (i=0; i<3; i++) f[i] /= len;
+
+   // s = f x up, u = s x f, with up = (0, 1, 0)
+   s[0] = -f[2]; s[1] = 0.0f; s[2] = f[0];
+   len = sqrt(s[0]*s[0] + s[2]*s[2]);
+   if (len == 0.0f) {
+      s[0] = 1.0f; s[2] = 0.0f;
+   }
+   else {
+      s[0] /= len; s[2] /= len;
+   }
+   u[0] = s[1]*f[2] - s[2]*f[1];
+   u[1] = s[2]*f[0] - s[0]*f[2];
+   u[2] = s[0]*f[1] - s[1]*f[0];
+
+   // column major, the rows are s, u and -f
+   for (i=0; i<3; i++) {
+       m[4*i]   = s[i];
+       m[4*i+1] = u[i];
+       m[4*i+2] = -f[i];
+       m[4*i+3] = 0.0f;
+   }
+   m[12] = m[13] = m[14] = 0.0f;
+   m[15] = 1.0f;
+
+   glMultMatrixf(m);
+   glTranslatef(-eye[0], -eye[1], -eye[2]);
+}
@@ -0,0 +1,71 @@
+// --------------------------------------------------------------------
+//  CameraPath.h
+//
+//  A scripted camera path, for rendering the same frames without
+//  user interaction.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CAMERAPATH
+#define CAMERAPATH
+
+#include <vector>
+
+using namespace std;
+
+//! A camera path given by key frames
+/*!
+  Every key frame is an eye point and a center of interest, the up
+  vector is the y-axis like in the GLUT window. Between the key frames
+  the eye point and the center are interpolated linearly, with the same
+  parameter length for every segment.
+
+  A path file contains one key frame per line, six floats: the eye
+  point and the center. Empty lines and lines starting with # are
+  ignored.
+*/
+class CameraPath
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, an empty path
+   CameraPath(void);
+
+   //! Read the key frames from a file, the old key frames are removed
+   /*!
+     The result is false, if the file can not be opened or contains
+     less than one key frame.
+   */
+   bool read(const char *filename);
+   //! A circle around a bounding box (xmin, xmax, ymin, ymax, zmin, zmax)
+   /*!
+     The eye points are on a circle around the y-axis through the
+     center of the box, at the distance of the diagonal and above the
+     box. The int is the number of key frames, the last one is the first.
+   */
+   void orbit(const float box[6], int keys);
+   //! Add a key frame
+   void addKey(const float eye[3], const float center[3]);
+   //! Query the number of key frames
+   int  getNumberOfKeys(void);
+
+   //! Eye point and center for the parameter t in [0, 1]
+   void getView(float t, float eye[3], float center[3]);
+   //! Multiply the viewing transformation for t onto the current matrix
+   /*!
+     Like gluLookAt(), without GLU.
+   */
+   void apply(float t);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Eye point and center, 6 floats for every key frame
+   vector<float> keys;
+};
+#endif
@@ -0,0 +1,309 @@
+// --------------------------------------------------------------------
+//  ContourEngine.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "ContourEngine.h"
+
+#include <math.h>
+#include <algorithm>
+
+ContourEngine::ContourEngine(void) : lines(0)
+{
+   values.push_back(0.0f);
+   useChunks = false;
+   wide.setWidth(0.0f);
+}
+
+void ContourEngine::setValue(float v)
+{
+   values.clear();
+   values.push_back(v);
+}
+
+void ContourEngine::generateValues(int n, float range[2])
+{
+   int i;
+
+   values.clear();
+   if (n < 2) {
+      values.push_back(0.5f*(range[0]+range[1]));
+      return;
+   }
+   for (i=0; i<n; i++)
+      values.push_back(range[0] + i*(range[1]-range[0])/(n-1));
+}
+
+int ContourEngine::getNumberOfValues(void)
+{
+   return values.size();
+}
+
+void ContourEngine::contour(const float *points, const GLuint *triangles,
+                            int numTriangles, const float *scalars)
+{
+   int t, k, inside;
+   unsigned int v;
+   const float *p[3];
+   float s[3], n[3];
+   bool above[3], normal;
+
+   // keep the capacity of the last contouring
+   lines.setNumberOfVertices(0);
+   segmentNormals.clear();
+
+   for (t=0; t<numTriangles; t++) {
+       for (k=0; k<3; k++) {
+           p[k] = points + 3*triangles[3*t+k];
+           s[k] = scalars[triangles[3*t+k]];
+       }
+       normal = false;
+       for (v=0; v<values.size(); v++) {
+           // a vertex with the contour value counts as above
+           inside = 0;
+           for (k=0; k<3; k++) {
+               above[k] = (s[k] >= values[v]);
+               if (above[k]) inside++;
+           }
+           if ((inside == 0) || (inside == 3)) continue;
+
+           // exactly two edges are crossed
+           for (k=0; k<3; k++)
+               if (above[k] != above[(k+1)%3])
+                  crossEdge(triangles + 3*t, k, p[k], p[(k+1)%3], s, values[v]);
+
+           // the normal of the triangle for the normal cones of the chunks
+           if (useChunks) {
+              if (!normal) faceNormal(p[0], p[1], p[2], n);
+              normal = true;
+              segmentNormals.insert(segmentNormals.end(), n, n+3);
+           }
+       }
+   }
+   if (useChunks) buildChunks();
+}
+
+void ContourEngine::contour(const short *points, const Quantization &q,
+                            const GLuint *triangles, int numTriangles,
+                            const float *scalars)
+{
+   int t, k, inside;
+   unsigned int v;
+   float p[3][3], s[3], n[3];
+   bool above[3], decoded;
+
+   lines.setNumberOfVertices(0);
+   segmentNormals.clear();
+
+   for (t=0; t<numTriangles; t++) {
+       for (k=0; k<3; k++)
+           s[k] = scalars[triangles[3*t+k]];
+       decoded = false;
+       for (v=0; v<values.size(); v++) {
+           inside = 0;
+           for (k=0; k<3; k++) {
+               above[k] = (s[k] >= values[v]);
+               if (above[k]) inside++;
+           }
+           if ((inside == 0) || (inside == 3)) continue;
+
+           // decode the points of the triangle only once
+           if (!decoded) {
+              for (k=0; k<3; k++)
+                  dequantizePoint(points + 3*triangles[3*t+k], q, p[k]);
+              if (useChunks) faceNormal(p[0], p[1], p[2], n);
+              decoded = true;
+           }
+           for (k=0; k<3; k++)
+               if (above[k] != above[(k+1)%3])
+                  crossEdge(triangles + 3*t, k, p[k], p[(k+1)%3], s, values[v]);
+           if (useChunks) segmentNormals.insert(segmentNormals.end(), n, n+3);
+       }
+   }
+   if (useChunks) buildChunks();
+}
+
+void ContourEngine::compare(const float *referencePoints, const float *points,
+                            const GLuint *triangles, int numTriangles,
+                            const float *referenceScalars, const float *scalars,
+                            float &maxError, float &meanError, int &changed)
+{
+   int t, k, a, b, i, count = 0;
+   unsigned int v, j;
+   float ta, tb, d, e;
+   double sum = 0.0;
+   bool crossRef, cross;
+   GLuint p, q;
+
+   maxError = 0.0f; changed = 0;
+
+   // interior edges belong to two triangles, every edge is compared once
+   vector<pair<GLuint, GLuint> > edges;
+   edges.reserve(3*numTriangles);
+   for (t=0; t<numTriangles; t++)
+   for (k=0; k<3; k++) {
+       p = triangles[3*t+k]; q = triangles[3*t+(k+1)%3];
+       edges.push_back((p < q) ? make_pair(p, q) : make_pair(q, p));
+   }
+   sort(edges.begin(), edges.end());
+   edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+   for (j=0; j<edges.size(); j++) {
+       a = edges[j].first; b = edges[j].second;
+       for (v=0; v<values.size(); v++) {
+           crossRef = ((referenceScalars[a] >= values[v]) !=
+                       (referenceScalars[b] >= values[v]));
+           cross    = ((scalars[a] >= values[v]) != (scalars[b] >= values[v]));
+           if (crossRef != cross) changed++;
+           if (!crossRef || !cross) continue;
+
+           ta = (values[v]-referenceScalars[a])/(referenceScalars[b]-referenceScalars[a]);
+           tb = (values[v]-scalars[a])/(scalars[b]-scalars[a]);
+           e = 0.0f;
+           for (i=0; i<3; i++) {
+               d = (referencePoints[3*a+i] + ta*(referencePoints[3*b+i]-referencePoints[3*a+i]))
+                 - (points[3*a+i] + tb*(points[3*b+i]-points[3*a+i]));
+               e += d*d;
+           }
+           e = sqrt(e);
+           if (e > maxError) maxError = e;
+           sum += e; count++;
+       }
+   }
+   meanError = (count > 0) ? static_cast<float>(sum/count) : 0.0f;
+}
+
+int ContourEngine::getNumberOfSegments(void)
+{
+   return lines.getNumberOfVertices()/2;
+}
+
+const float* ContourEngine::getSegments(void)
+{
+   return (const float*) lines.getVertices();
+}
+
+long ContourEngine::getMemorySize(void)
+{
+   return lines.getMemorySize() + segmentNormals.capacity()*sizeof(float);
+}
+
+void ContourEngine::draw(void)
+{
+   GLfloat color[4];
+   const float *v;
+   int i, n;
+
+   // the lines have no normals
+   if (wide.getWidth() <= 0.0f) {
+      if (useChunks)
+         chunks.draw(&lines);
+      else
+         lines.draw(GL_LINES);
+      return;
+   }
+
+   glGetFloatv(GL_CURRENT_COLOR, color);
+   wide.setColor(color);
+   if (useChunks) {
+      chunks.draw(&lines, &wide);
+      return;
+   }
+   v = getSegments();
+   n = getNumberOfSegments();
+   wide.begin();
+   for (i=0; i<n; i++) wide.addSegment(v + 6*i, v + 6*i + 3);
+   wide.end();
+}
+
+void ContourEngine::setLineWidth(float w)
+{
+   wide.setWidth(w);
+}
+
+float ContourEngine::getLineWidth(void)
+{
+   return wide.getWidth();
+}
+
+MeshBuffer* ContourEngine::getMeshBuffer(void)
+{
+   return &lines;
+}
+
+void ContourEngine::setChunks(bool on)
+{
+   useChunks = on;
+   if (useChunks)
+      buildChunks();
+   else
+      lines.setIndices(0, 0);
+}
+
+bool ContourEngine::getChunks(void)
+{
+   return useChunks;
+}
+
+LineChunks* ContourEngine::getLineChunks(void)
+{
+   return &chunks;
+}
+
+//
+// private
+//
+
+// Without the normals of the last contouring, e.g. if the chunks were
+// switched on afterwards, the chunks have no normal cones.
+void ContourEngine::buildChunks(void)
+{
+   if (segmentNormals.size() == 3*(unsigned int) getNumberOfSegments())
+      chunks.build(&lines, segmentNormals.empty() ? 0 : &segmentNormals[0]);
+   else
+      chunks.build(&lines);
+}
+
+// Counterclockwise triangles are front facing, like glFrontFace(GL_CCW)
+void ContourEngine::faceNormal(const float *p0, const float *p1, const float *p2,
+                               float n[3])
+{
+   float e1[3], e2[3];
+   int k;
+
+   for (k=0; k<3; k++) {
+       e1[k] = p1[k]-p0[k];
+       e2[k] = p2[k]-p0[k];
+   }
+   n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+   n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+   n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+}
+
+// The triangles on both sides of an edge compute the crossing from the
+// point with the smaller index, so the crossings are equal.
+void ContourEngine::crossEdge(const GLuint *triangle, int k, const float *a,
+                              const float *b, const float *s, float value)
+{
+   int l = (k+1)%3;
+
+   if (triangle[k] < triangle[l])
+      addCrossing(a, b, s[k], s[l], value);
+   else
+      addCrossing(b, a, s[l], s[k], value);
+}
+
+void ContourEngine::addCrossing(const float *a, const float *b,
+                                float sa, float sb, float value)
+{
+   float p[3], t = (value-sa)/(sb-sa);
+
+   p[0] = a[0] + t*(b[0]-a[0]);
+   p[1] = a[1] + t*(b[1]-a[1]);
+   p[2] = a[2] + t*(b[2]-a[2]);
+   lines.addVertex(p);
+}
@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------
+//  ContourEngine.h
+//
+//  Contouring of scalars on a triangle mesh given as compact arrays,
+//  without a VTK pipeline.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CONTOURENGINE
+#define CONTOURENGINE
+
+#include <vector>
+#include <GL/glu.h>
+
+#include "ScalarKernels.h"
+#include "MeshBuffer.h"
+#include "LineChunks.h"
+#include "WideLines.h"
+
+using namespace std;
+
+//! A class computing isolines on a triangle mesh
+/*!
+  The mesh is given as packed arrays, like in the compact mode of
+  \link InterrogationObject \endlink: 3 floats for every point and
+  3 indices for every triangle. For every triangle and every contour
+  value the isoline is a line segment (marching triangles).
+
+  The segments are written directly into the client copy of a
+  MeshBuffer, which is the source of the vertex array or buffer object
+  for the rendering. There is no copy between the contouring and the
+  rendering. The array is reused by the next contouring, so an
+  interactive recomputation does not allocate memory once the array
+  is big enough. Frames without a new contouring do not send the
+  segments again.
+
+  With ::setChunks() the segments are split into \link LineChunks
+  \endlink after every contouring, then ::draw() culls the chunks
+  against the view and draws simplified levels for distant chunks.
+  The normal of the triangle of every segment is kept for the chunks,
+  so back facing chunks can be skipped as well.
+  With ::setLineWidth() the segments are drawn as \link WideLines
+  \endlink instead of GL_LINES.
+*/
+class ContourEngine
+{
+public:
+   //! Default constructor, one contour value 0
+   ContourEngine(void);
+
+   //! Set one contour value
+   void setValue(float);
+   //! Generate n contour values equally spaced in the range
+   void generateValues(int n, float range[2]);
+   //! Query the number of contour values
+   int  getNumberOfValues(void);
+
+   //! Compute the isolines
+   /*!
+     The arguments are the points, the triangles, the number of triangles
+     and one scalar for every point.
+   */
+   void contour(const float *points, const GLuint *triangles, int numTriangles,
+                const float *scalars);
+   //! Compute the isolines on quantized points
+   /*!
+     Only the points of triangles crossed by an isoline are decoded.
+   */
+   void contour(const short *points, const Quantization&, const GLuint *triangles,
+                int numTriangles, const float *scalars);
+
+   //! Compare the isolines of two sets of scalars
+   /*!
+     Every edge of the triangles is visited once, also if it is shared
+     by two triangles. For every edge crossed by an isoline in both
+     cases the distance of the crossings is computed, using the
+     reference points for the reference scalars and the second points
+     for the other scalars.
+     The maximal and the mean distance are given back, and the
+     number of crossings only found in one case.
+   */
+   void compare(const float *referencePoints, const float *points,
+                const GLuint *triangles, int numTriangles,
+                const float *referenceScalars, const float *scalars,
+                float &maxError, float &meanError, int &changed);
+
+   //! Query the number of line segments
+   int getNumberOfSegments(void);
+   //! Query the line segments, 6 floats for every segment
+   const float* getSegments(void);
+   //! Query the memory used by the segments in bytes
+   long getMemorySize(void);
+
+   //! Render the line segments in the current color
+   /*!
+     The segments are drawn as GL_LINES, or as quads if a line width
+     is set.
+   */
+   void draw(void);
+   //! Set the width of the lines in pixels, 0 for GL_LINES, the default
+   void  setLineWidth(float);
+   //! Query the width of the lines in pixels, 0 for GL_LINES
+   float getLineWidth(void);
+   //! The buffer with the line segments for the rendering
+   MeshBuffer* getMeshBuffer(void);
+
+   //! Use chunks with culling and levels of detail for the rendering
+   void setChunks(bool);
+   //! Are chunks used for the rendering?
+   bool getChunks(void);
+   //! The chunks, e.g. to set the levels or query the statistics
+   LineChunks* getLineChunks(void);
+
+private:
+   //! The contour values
+   vector<float> values;
+   //! The end points of the line segments, positions only
+   MeshBuffer lines;
+   //! Chunks of the line segments
+   LineChunks chunks;
+   //! Are the chunks used?
+   bool useChunks;
+   //! Normal of the triangle of every segment, only if the chunks are used
+   vector<float> segmentNormals;
+   //! Quads for the wide lines, width 0 for GL_LINES
+   WideLines wide;
+
+   // split the segments into chunks, with the normals if they are valid
+   void buildChunks(void);
+   // the normal of a triangle, not normalized
+   void faceNormal(const float *p0, const float *p1, const float *p2, float n[3]);
+   // the crossing of the edge k of a triangle, s are the scalars of the triangle
+   void crossEdge(const GLuint *triangle, int k, const float *a, const float *b,
+                  const float *s, float value);
+   // add the point on the edge (a,b), where the scalar is value
+   void addCrossing(const float *a, const float *b, float sa, float sb, float value);
+};
+#endif
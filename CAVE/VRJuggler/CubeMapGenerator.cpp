@@ -0,0 +1,355 @@
+// --------------------------------------------------------------------
+//  CubeMapGenerator.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "CubeMapGenerator.h"
+
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// OpenGL 1.3, not in every gl.h
+#ifndef GL_TEXTURE_CUBE_MAP
+#define GL_REFLECTION_MAP              0x8512
+#define GL_TEXTURE_CUBE_MAP            0x8513
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE               0x812F
+#endif
+#ifndef GL_TEXTURE_WRAP_R
+#define GL_TEXTURE_WRAP_R              0x8072
+#endif
+
+// The direction of a texel in column sc and row tc, both in [-1, 1],
+// is base + sc*du + tc*dv, in the order and orientation of the
+// GL_TEXTURE_CUBE_MAP faces.
+static const float faceBase[6][3] = {{ 1, 0, 0}, {-1, 0, 0}, {0,  1, 0},
+                                     { 0,-1, 0}, { 0, 0, 1}, {0,  0,-1}};
+static const float faceU[6][3]    = {{ 0, 0,-1}, { 0, 0, 1}, {1,  0, 0},
+                                     { 1, 0, 0}, { 1, 0, 0}, {-1, 0, 0}};
+static const float faceV[6][3]    = {{ 0,-1, 0}, { 0,-1, 0}, {0,  0, 1},
+                                     { 0, 0,-1}, { 0,-1, 0}, {0, -1, 0}};
+
+// Arguments for a block of rows
+struct RowJob
+{
+   CubeMapGenerator *generator;
+   int first, last;
+   bool started;
+};
+
+static inline void cross(const float a[3], const float b[3], float c[3])
+{
+   c[0] = a[1]*b[2] - a[2]*b[1];
+   c[1] = a[2]*b[0] - a[0]*b[2];
+   c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static inline float dot(const float a[3], const float b[3])
+{
+   return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+// The light forms of LightCage::attenuate() as a polynomial in
+// x = |pD| <= 1, the value is k[0] + k[1]x + k[2]x^2 + k[3]x^3.
+static void lightForm(LightLine::Attenuation a, float k[4])
+{
+   k[0] = 1.0f; k[1] = 0.0f; k[2] = 0.0f; k[3] = 0.0f;
+   switch (a) {
+           case LightLine::Linear:
+                       k[1] = -1.0f;
+                       break;
+           case LightLine::Quadratic:
+                       k[2] = -1.0f;
+                       break;
+           case LightLine::Polynomial:
+                       k[2] = -3.0f; k[3] = 2.0f;
+                       break;
+           case LightLine::Constant:
+                       break;
+           default:
+                       k[0] = 0.0f;
+                       break;
+   }
+}
+
+// Below this the ray is parallel to the line, the numerator is 0 too
+static const float minimalDenominator = 1.0E-20f;
+
+CubeMapGenerator::CubeMapGenerator(LightCage *c, int s)
+{
+   cage = c;
+   size = (s < 1) ? 1 : s;
+   origin[0] = 0.0f; origin[1] = 0.0f; origin[2] = 0.0f;
+   threads = 0;
+   faceRevision = 0;
+   loaded = false;
+   texture = 0;
+}
+
+CubeMapGenerator::~CubeMapGenerator(void)
+{
+   if (texture != 0) glDeleteTextures(1, &texture);
+}
+
+void CubeMapGenerator::setOrigin(float x, float y, float z)
+{
+   origin[0] = x; origin[1] = y; origin[2] = z;
+   faceRevision = 0;
+}
+
+void CubeMapGenerator::getOrigin(float o[3])
+{
+   o[0] = origin[0]; o[1] = origin[1]; o[2] = origin[2];
+}
+
+void CubeMapGenerator::setSize(int s)
+{
+   size = (s < 1) ? 1 : s;
+   faceRevision = 0;
+}
+
+int CubeMapGenerator::getSize(void)
+{
+   return size;
+}
+
+void CubeMapGenerator::setThreads(int n)
+{
+   threads = (n < 1) ? 1 : n;
+}
+
+int CubeMapGenerator::getThreads(void)
+{
+   if (threads == 0) {
+      threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+      if (threads < 1) threads = 1;
+   }
+   return threads;
+}
+
+bool CubeMapGenerator::update(void)
+{
+   if ((faceRevision != 0) && (faceRevision == cage->getRevision()))
+      return false;
+
+   compute();
+   return true;
+}
+
+void CubeMapGenerator::compute(void)
+{
+   int t, block, n = getThreads(), rows = 6*size;
+   pthread_t *ids;
+   RowJob *jobs;
+
+   for (int f=0; f<6; f++)
+       faces[f].resize(size*size);
+
+   if (n > rows) n = rows;
+   if (n <= 1)
+      computeRows(0, rows);
+   else {
+      ids  = new pthread_t[n];
+      jobs = new RowJob[n];
+      block = (rows + n - 1)/n;
+      for (t=0; t<n; t++) {
+          jobs[t].generator = this;
+          jobs[t].first = t*block;
+          jobs[t].last  = (t+1)*block < rows ? (t+1)*block : rows;
+          jobs[t].started = (pthread_create(&ids[t], NULL, rowThread, &jobs[t]) == 0);
+          // no thread available, do it here
+          if (!jobs[t].started) computeRows(jobs[t].first, jobs[t].last);
+      }
+      for (t=0; t<n; t++)
+          if (jobs[t].started) pthread_join(ids[t], NULL);
+
+      delete [] ids;
+      delete [] jobs;
+   }
+
+   faceRevision = cage->getRevision();
+   loaded = false;
+}
+
+const unsigned char* CubeMapGenerator::getFace(int f)
+{
+   if ((f < 0) || (f > 5) || faces[f].empty()) return 0;
+   return &faces[f][0];
+}
+
+GLuint CubeMapGenerator::upload(void)
+{
+   if (faces[0].empty()) compute();
+   if (texture == 0) {
+      glGenTextures(1, &texture);
+      loaded = false;
+   }
+
+   glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+   if (!loaded) {
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+      for (int f=0; f<6; f++)
+          glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X+f, 0, GL_LUMINANCE,
+                       size, size, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                       &faces[f][0]);
+      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+      loaded = true;
+   }
+   return texture;
+}
+
+void CubeMapGenerator::enable(void)
+{
+   GLfloat m[16], inverse[16];
+   int i, j;
+
+   upload();
+
+   // the transposed rotation of the viewing transformation brings the
+   // reflected vector in eye coordinates back to world coordinates
+   glGetFloatv(GL_MODELVIEW_MATRIX, m);
+   for (i=0; i<16; i++) inverse[i] = (i%5 == 0) ? 1.0f : 0.0f;
+   for (i=0; i<3; i++)
+       for (j=0; j<3; j++)
+           inverse[4*j+i] = m[4*i+j];
+
+   glMatrixMode(GL_TEXTURE);
+   glPushMatrix();
+   glLoadMatrixf(inverse);
+   glMatrixMode(GL_MODELVIEW);
+
+   glTexGeni(GL_S, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
+   glTexGeni(GL_T, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
+   glTexGeni(GL_R, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
+   glEnable(GL_TEXTURE_GEN_S);
+   glEnable(GL_TEXTURE_GEN_T);
+   glEnable(GL_TEXTURE_GEN_R);
+   glEnable(GL_TEXTURE_CUBE_MAP);
+}
+
+void CubeMapGenerator::disable(void)
+{
+   glDisable(GL_TEXTURE_CUBE_MAP);
+   glDisable(GL_TEXTURE_GEN_S);
+   glDisable(GL_TEXTURE_GEN_T);
+   glDisable(GL_TEXTURE_GEN_R);
+
+   glMatrixMode(GL_TEXTURE);
+   glPopMatrix();
+   glMatrixMode(GL_MODELVIEW);
+}
+
+//
+// Private Functions
+//
+void* CubeMapGenerator::rowThread(void *arg)
+{
+   RowJob *job = (RowJob*) arg;
+
+   job->generator->computeRows(job->first, job->last);
+   return NULL;
+}
+
+// The rows are numbered face by face. For the texel in column sc the
+// direction is r = rowBase + sc*du, so for a line with point p and
+// direction d the cross product d x r is c0 + sc*c1. The distance of
+// the ray and the line is |(d x r).(p - origin)|/|d x r|, the numerator
+// is linear in sc and the squared denominator quadratic.
+void CubeMapGenerator::computeRows(int first, int last)
+{
+   int row, f, j, i, l, n = cage->size();
+   float tc, rowBase[3], q[3], c0[3], c1[3];
+   float a0, a1, b0, b1, b2, invRadius, k[4];
+   float sc, num, den, x, value;
+   const float *p = cage->getPoints(), *d = cage->getDirections(),
+               *r = cage->getRadii();
+   float *sum = new float[size], *column = new float[size];
+   unsigned char *image;
+
+   for (i=0; i<size; i++)
+       column[i] = 2.0f*(i+0.5f)/size - 1.0f;
+
+   for (row=first; row<last; row++) {
+       f = row/size; j = row%size;
+       tc = 2.0f*(j+0.5f)/size - 1.0f;
+       rowBase[0] = faceBase[f][0] + tc*faceV[f][0];
+       rowBase[1] = faceBase[f][1] + tc*faceV[f][1];
+       rowBase[2] = faceBase[f][2] + tc*faceV[f][2];
+
+       for (i=0; i<size; i++) sum[i] = 0.0f;
+
+       for (l=0; l<n; l++) {
+           // lines with radius 0 are not visible
+           if (r[l] <= 0.0f) continue;
+           q[0] = p[3*l]-origin[0]; q[1] = p[3*l+1]-origin[1]; q[2] = p[3*l+2]-origin[2];
+           cross(d+3*l, rowBase, c0);
+           cross(d+3*l, faceU[f], c1);
+           a0 = dot(c0, q); a1 = dot(c1, q);
+           b0 = dot(c0, c0); b1 = 2.0f*dot(c0, c1); b2 = dot(c1, c1);
+           invRadius = 1.0f/r[l];
+           lightForm(cage->getAttenuation(l), k);
+
+           i = 0;
+#ifdef __SSE2__
+           __m128 va0 = _mm_set1_ps(a0), va1 = _mm_set1_ps(a1),
+                  vb0 = _mm_set1_ps(b0), vb1 = _mm_set1_ps(b1),
+                  vb2 = _mm_set1_ps(b2), vr = _mm_set1_ps(invRadius),
+                  vk0 = _mm_set1_ps(k[0]), vk1 = _mm_set1_ps(k[1]),
+                  vk2 = _mm_set1_ps(k[2]), vk3 = _mm_set1_ps(k[3]),
+                  one = _mm_set1_ps(1.0f),
+                  tiny = _mm_set1_ps(minimalDenominator),
+                  absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+           for (; i+4<=size; i+=4) {
+               __m128 vs = _mm_loadu_ps(column+i);
+               __m128 vn = _mm_add_ps(va0, _mm_mul_ps(vs, va1));
+               __m128 vd = _mm_add_ps(vb0, _mm_mul_ps(vs, _mm_add_ps(vb1, _mm_mul_ps(vs, vb2))));
+               __m128 vt = _mm_mul_ps(_mm_div_ps(_mm_and_ps(vn, absMask),
+                                                 _mm_sqrt_ps(_mm_max_ps(vd, tiny))), vr);
+               __m128 inside = _mm_cmple_ps(vt, one);
+               __m128 vx = _mm_min_ps(vt, one);
+               __m128 vv = _mm_add_ps(vk0, _mm_mul_ps(vx,
+                           _mm_add_ps(vk1, _mm_mul_ps(vx,
+                           _mm_add_ps(vk2, _mm_mul_ps(vx, vk3))))));
+               vv = _mm_and_ps(vv, inside);
+               _mm_storeu_ps(sum+i, _mm_max_ps(_mm_loadu_ps(sum+i), vv));
+           }
+#endif
+           for (; i<size; i++) {
+               sc = column[i];
+               num = a0 + sc*a1;
+               den = b0 + sc*(b1 + sc*b2);
+               if (den < minimalDenominator) den = minimalDenominator;
+               x = fabsf(num)/sqrtf(den)*invRadius;
+               if (x > 1.0f) continue;
+               value = k[0] + x*(k[1] + x*(k[2] + x*k[3]));
+               if (value > sum[i]) sum[i] = value;
+           }
+       }
+
+       image = &faces[f][j*size];
+       for (i=0; i<size; i++) {
+           value = sum[i];
+           if (value < 0.0f) value = 0.0f;
+           if (value > 1.0f) value = 1.0f;
+           image[i] = static_cast<unsigned char>(255.0f*value + 0.5f);
+       }
+   }
+
+   delete [] sum;
+   delete [] column;
+}
@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------
+//  CubeMapGenerator.h
+//
+//  Render a light cage into the six faces of a cube map, for
+//  reflection lines from a static environment.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef CUBEMAPGENERATOR
+#define CUBEMAPGENERATOR
+
+#include <vector>
+#include <GL/gl.h>
+
+#include "LightCage.h"
+
+using namespace std;
+
+//! Cube map of the luminance of a light cage
+/*!
+  Reflection lines computed with a sphere map depend on the view point,
+  the texture has to be computed again whenever the head moves. A cube
+  map stores the luminance of the cage for every direction seen from an
+  origin, usually the center of the interrogated object. With texture
+  coordinates generated as GL_REFLECTION_MAP and the inverse rotation
+  of the viewing transformation in the texture matrix the environment
+  is fixed in world coordinates and the texture does not depend on the
+  view.
+
+  The luminance of a texel with the direction r is the luminance of
+  the cage lines at the distance of the line through the origin with
+  direction r, combined with the maximum. The lines of a cage are
+  infinite, like in LightCage::computeScalar() for reflection lines,
+  so every line is a band along a great circle of the cube.
+
+  Along a row of a face the distance of the ray and a light line is a
+  quotient of two polynomials in the column coordinate, their
+  coefficients are computed once per row and line. With SSE2 (__SSE2__)
+  four texels are computed at once. The faces are split into blocks of
+  rows, computed by a number of threads.
+
+  The cube map is computed again by ::update() only if the revision of
+  the cage has changed, or the origin or the size.
+*/
+class CubeMapGenerator
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Constructor for a cage and the edge length of the faces in texels
+   CubeMapGenerator(LightCage *cage, int size);
+   //! Destructor, the texture object is deleted
+   ~CubeMapGenerator(void);
+
+   //! Set the origin of the cube map, the default is (0, 0, 0)
+   void setOrigin(float x, float y, float z);
+   //! Query the origin of the cube map
+   void getOrigin(float o[3]);
+   //! Set the edge length of the faces in texels
+   void setSize(int);
+   //! Query the edge length of the faces in texels
+   int  getSize(void);
+
+   //! Set the number of threads, the default is the number of processors online
+   void setThreads(int);
+   //! Query the number of threads
+   int  getThreads(void);
+
+   //! Compute the faces, if the cage or the parameters have changed
+   /*!
+     The result is true, if the faces were computed again.
+   */
+   bool update(void);
+   //! Compute the faces
+   void compute(void);
+
+   //! Query a face in GL order: +x, -x, +y, -y, +z, -z
+   /*!
+     The face is a GL_LUMINANCE image with size*size bytes, row by row.
+   */
+   const unsigned char* getFace(int);
+
+   //! Load the faces into a GL_TEXTURE_CUBE_MAP texture object
+   /*!
+     The texture object is created with the first call and loaded again
+     after every computation of the faces. A valid GL context is needed.
+   */
+   GLuint upload(void);
+   //! Enable the cube map with texture coordinates GL_REFLECTION_MAP
+   /*!
+     The viewing transformation has to be on the modelview stack, its
+     inverse rotation is loaded as texture matrix.
+   */
+   void enable(void);
+   //! Disable the cube map, the texture matrix is restored
+   void disable(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The light cage
+   LightCage *cage;
+   //! Edge length of the faces in texels
+   int size;
+   //! Origin of the cube map
+   float origin[3];
+   //! Number of threads
+   int threads;
+   //! The six faces, size*size bytes each
+   vector<unsigned char> faces[6];
+   //! Revision of the cage the faces are computed for, 0 if not computed
+   unsigned int faceRevision;
+   //! Are the faces newer than the texture object?
+   bool loaded;
+   //! The texture object, 0 if not created
+   GLuint texture;
+
+   //! Compute the rows [first, last) of all faces, called by the threads
+   void computeRows(int first, int last);
+   // the thread function, the argument is a RowJob
+   static void* rowThread(void*);
+};
+#endif
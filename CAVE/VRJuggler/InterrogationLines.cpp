@@ -17,6 +17,16 @@
 #include <vtkPointData.h>
 #include <vtkContourFilter.h>
 
+InterrogationLines::InterrogationLines(void)
+{
+   contourEngine = new ContourEngine;
+}
+
+InterrogationLines::~InterrogationLines(void)
+{
+   delete contourEngine;
+}
+
 // Bei Isophoten gibt es eine eigene ::compute. Sobald die funktioniert diese
 // hier nochmal berarbeiten!
 void InterrogationLines::compute(void)
@@ -24,6 +34,9 @@ void InterrogationLines::compute(void)
    double range[2];
    list<LightLine>::iterator iter = cage->begin(), end = cage->end();
 
+   // compact mode: the VTK data is deleted after reading
+   if (surfaceNet->getVTKData() == 0) return;
+
    vtkFloatArray *highlightNumbers = vtkFloatArray::New();
    vtkContourFilter *iso = vtkContourFilter::New();
    vtkPolyData *local = vtkPolyData::New();
@@ -83,6 +96,46 @@ void InterrogationLines::setInterrogationObject(InterrogationObject *net)
    surfaceNet = net;
 }
 
+void InterrogationLines::draw(void)
+{
+   if (surfaceNet->getCompactMode())
+      contourEngine->draw();
+   else
+      setPointerAndDraw();
+}
+
+long InterrogationLines::getMemorySize(void)
+{
+   return contourEngine->getMemorySize() +
+          compactScalars.capacity()*sizeof(float);
+}
+
+ContourEngine* InterrogationLines::getContourEngine(void)
+{
+   return contourEngine;
+}
+
+void InterrogationLines::contourCompact(void)
+{
+   // no points: no triangles and no isolines
+   if (compactScalars.empty()) {
+      contourEngine->contour(surfaceNet->getPointArray(), 0, 0, 0);
+      return;
+   }
+
+   if (surfaceNet->isCompressed())
+      contourEngine->contour(surfaceNet->getQuantizedPoints(),
+                             surfaceNet->getQuantization(),
+                             surfaceNet->getTriangleArray(),
+                             surfaceNet->getNumberOfTriangles(),
+                             &compactScalars[0]);
+   else
+      contourEngine->contour(surfaceNet->getPointArray(),
+                             surfaceNet->getTriangleArray(),
+                             surfaceNet->getNumberOfTriangles(),
+                             &compactScalars[0]);
+}
+
 void InterrogationLines::setRadius(float r)
 {
    radius = r;
@@ -11,6 +11,7 @@
 #ifndef INTERROGATIONLINES
 #define INTERROGATIONLINES
 #include <list>
+#include <vector>
 
 #include <GL/glu.h>
 #include <vtkFloatArray.h>
@@ -21,6 +22,7 @@
 #include "LightCage.h"
 #include "LightVector.h"
 #include "InterrogationObject.h"
+#include "ContourEngine.h"
 
 using namespace std;
 
@@ -32,11 +34,20 @@ using namespace std;
 class InterrogationLines : public vlgGetVTKPolyData
 {
 public:
+   //! Default constructor
+   /*!
+     The contour engine for the compact mode is created.
+   */
+   InterrogationLines(void);
+   //! Destructor, deleting the contour engine
+   virtual ~InterrogationLines(void);
+
    // scalars for the isolines
    //! Compute the lines
    /*!
      This is the central function of all classes derived from
-     InterrogationLines.
+     InterrogationLines. In compact mode there is no VTK data, nothing
+     is computed for the light cage.
    */
    virtual void compute(void); // Compute the line
    //! Texture object
@@ -53,6 +64,18 @@ public:
    //! Set the surface to be interrogated
    void setInterrogationObject(InterrogationObject*);
 
+   //! Render the lines
+   /*!
+     If the interrogated object is in compact mode, the line segments
+     of the contour engine are rendered, otherwise setPointerAndDraw()
+     is called.
+   */
+   void draw(void);
+   //! Query the memory used by the lines and the scalars in compact mode in bytes
+   long getMemorySize(void);
+   //! The contour engine of the compact mode, e.g. to switch on the chunks
+   ContourEngine* getContourEngine(void);
+
    //! Set the radius of the light cylinders
    void  setRadius(float);
    //! Query the radius of the light cylinders
@@ -128,6 +151,20 @@ protected:
    bool       preFilterMap; // Toggle for preFilter texture maps. 
                             // Default is No.
 
+   //! Contouring of the packed arrays in compact mode
+   ContourEngine *contourEngine;
+   //! Scalars for the points in compact mode, reused for every computation
+   vector<float> compactScalars;
+
+   //! Contour the scalars in compactScalars
+   /*!
+     The packed arrays of the interrogated object are used, the
+     quantized points if the object is compressed. The
+     segments are stored in the contour engine. Without scalars the
+     engine is emptied.
+   */
+   void contourCompact(void);
+
    // private function
    //! Here is the difference!
    /*!
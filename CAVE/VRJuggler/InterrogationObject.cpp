@@ -9,59 +9,127 @@
 
 #include <vtkPolyDataReader.h>
 #include <vtkPolyData.h>
+#include <vtkPointData.h>
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
 //#include <vtkDataArray.h> // fr die TCoords
 
 #include "InterrogationObject.h"
 #include "vlgTexturemap2D.h"
 #include "Vector3.h"
 
+#include <math.h>
+
+// Anzahl der Chunks entlang jeder Achse fuer das Back-Face-Culling
+static const int chunkResolution = 8;
+
 // Constructors
 InterrogationObject::InterrogationObject(void) : vlgGetVTKPolyData()
 {
 	//verboseOn();
 
-	color[0] = 1.0f; color[1] = 0.0f; color[2] = 0.0f;
-	textured = false;
-	bbox = new float[6];
+	init();
 }
 
+// Die gepackten Arrays werden kopiert, der MeshBuffer und die Chunks
+// werden beim ersten draw() neu aufgebaut
 InterrogationObject::InterrogationObject(const InterrogationObject& copy)
 {
+	int k;
+
+	init();
 	color[0] = copy.color[0];
 	color[1] = copy.color[1];
 	color[2] = copy.color[2];
 	textured = copy.textured;
-	bbox = new float[6];
+	for (k=0; k<6; k++) bbox[k] = copy.bbox[k];
+
+	compactMode = copy.compactMode;
+	numCompactPoints = copy.numCompactPoints;
+	numTriangles = copy.numTriangles;
+	compressed = copy.compressed;
+	quantization = copy.quantization;
+	backFaceCulling = copy.backFaceCulling;
+	if (copy.pointArray != 0) {
+		pointArray = new float[3*numCompactPoints];
+		for (k=0; k<3*numCompactPoints; k++) pointArray[k] = copy.pointArray[k];
+	}
+	if (copy.normalArray != 0) {
+		normalArray = new float[3*numCompactPoints];
+		for (k=0; k<3*numCompactPoints; k++) normalArray[k] = copy.normalArray[k];
+	}
+	if (copy.triangleArray != 0) {
+		triangleArray = new GLuint[3*numTriangles];
+		for (k=0; k<3*numTriangles; k++) triangleArray[k] = copy.triangleArray[k];
+	}
+	if (copy.quantizedPoints != 0) {
+		quantizedPoints = new short[3*numCompactPoints];
+		for (k=0; k<3*numCompactPoints; k++) quantizedPoints[k] = copy.quantizedPoints[k];
+	}
+	if (copy.octNormals != 0) {
+		octNormals = new unsigned int[numCompactPoints];
+		for (k=0; k<numCompactPoints; k++) octNormals[k] = copy.octNormals[k];
+	}
+	if (copy.renderNormals != 0) {
+		renderNormals = new GLbyte[4*numCompactPoints];
+		for (k=0; k<4*numCompactPoints; k++) renderNormals[k] = copy.renderNormals[k];
+	}
 }
 
 InterrogationObject::InterrogationObject(char *fileName) : vlgGetVTKPolyData()
 {
-	bbox = new float[6];
+	init();
 	data = vtkPolyData::New();
-	color[0] = 1.0f; 
-	color[1]= 0.0f; 
-	color[2] = 0.0f;
-	textured = false;
 	readObject(fileName);
 }
 
 InterrogationObject::InterrogationObject(char *fileName, bool tex) : vlgGetVTKPolyData()
 {
-	bbox = new float[6];
+	init();
 	data = vtkPolyData::New();
-	color[0] = 1.0f; 
-	color[1]= 0.0f; 
-	color[2] = 0.0f;
 	textured = tex;
 	readObject(fileName);
 }
 
+InterrogationObject::InterrogationObject(char *fileName, bool tex, bool c) : vlgGetVTKPolyData()
+{
+	init();
+	compactMode = c;
+	// im kompakten Modus gibt es keine VTK-Daten
+	if (!compactMode) data = vtkPolyData::New();
+	textured = tex;
+	readObject(fileName);
+}
+
+// Destructor, der MeshBuffer gibt seine Buffer-Objekte frei
+InterrogationObject::~InterrogationObject(void)
+{
+	delete [] bbox;
+	delete [] pointArray;
+	delete [] normalArray;
+	delete [] triangleArray;
+	delete [] quantizedPoints;
+	delete [] octNormals;
+	delete [] renderNormals;
+	delete mesh;
+}
+
 void InterrogationObject::readObject(char *fileName)
 {
         // ----- Die VTK-Pipeline  --------------------------
 	vtkPolyDataReader *reader = vtkPolyDataReader::New();
 	reader->SetFileName(fileName);
         // ----- Die VTK-Pipeline  --------------------------
+
+	// Compact mode: convert into packed arrays, nothing of the
+	// VTK pipeline survives.
+	if (compactMode) {
+		reader->Update();
+		compact(reader->GetOutput());
+		reader->Delete();
+		return;
+	}
+
 	doAttributes();
 	doPointData();
 	noLines();
@@ -85,6 +153,7 @@ void InterrogationObject::readObject(char *fileName)
 // Das Objekt als Instanz von vtkPolyData zurckgeben
 vtkPolyData* InterrogationObject::getVTKData(void)
 {
+	if (compactMode) return 0;
 	return data;
 }
 
@@ -159,3 +228,464 @@ void InterrogationObject::setObject(vtkPolyData *o)
 	for (int i=0; i<6; i++)
 		bbox[i] = static_cast<float>(b[i]);
 }
+
+void InterrogationObject::setCompactMode(bool c)
+{
+	compactMode = c;
+}
+
+bool InterrogationObject::getCompactMode(void)
+{
+	return compactMode;
+}
+
+// Gemeinsame Initialisierung aller Konstruktoren
+void InterrogationObject::init(void)
+{
+	color[0] = 1.0f; color[1] = 0.0f; color[2] = 0.0f;
+	textured = false;
+	bbox = new float[6];
+	compactMode = false;
+	numCompactPoints = numTriangles = 0;
+	pointArray = normalArray = 0;
+	triangleArray = 0;
+	compressed = false;
+	quantizedPoints = 0;
+	octNormals = 0;
+	renderNormals = 0;
+	mesh = 0;
+	backFaceCulling = false;
+	chunksValid = false;
+	drawnTriangles = backFacingTriangles = 0;
+}
+
+void InterrogationObject::compact(vtkPolyData *o)
+{
+	int i, k, t;
+	vtkIdType npts, *pts;
+	vtkCellArray *polys = o->GetPolys(), *strips = o->GetStrips();
+	vtkDataArray *normals = o->GetPointData()->GetNormals();
+
+	delete [] pointArray;
+	delete [] normalArray;
+	delete [] triangleArray;
+	delete [] quantizedPoints;
+	delete [] octNormals;
+	delete [] renderNormals;
+	quantizedPoints = 0; octNormals = 0; renderNormals = 0;
+	compressed = false;
+	delete mesh;
+	mesh = 0;
+
+	numCompactPoints = o->GetNumberOfPoints();
+	pointArray  = new float[3*numCompactPoints];
+	normalArray = new float[3*numCompactPoints];
+	for (i=0; i<numCompactPoints; i++) {
+		double *p = o->GetPoint(i);
+		for (k=0; k<3; k++)
+			pointArray[3*i+k] = static_cast<float>(p[k]);
+	}
+
+	// Polygone als Faecher, Streifen als einzelne Dreiecke
+	numTriangles = 0;
+	for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+		numTriangles += npts-2;
+	for (strips->InitTraversal(); strips->GetNextCell(npts, pts); )
+		numTriangles += npts-2;
+	triangleArray = new GLuint[3*numTriangles];
+
+	t = 0;
+	for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+		for (i=1; i<npts-1; i++, t++) {
+			triangleArray[3*t]   = pts[0];
+			triangleArray[3*t+1] = pts[i];
+			triangleArray[3*t+2] = pts[i+1];
+		}
+	for (strips->InitTraversal(); strips->GetNextCell(npts, pts); )
+		for (i=0; i<npts-2; i++, t++) {
+			// jedes zweite Dreieck umdrehen
+			triangleArray[3*t]   = pts[(i%2 == 0) ? i : i+1];
+			triangleArray[3*t+1] = pts[(i%2 == 0) ? i+1 : i];
+			triangleArray[3*t+2] = pts[i+2];
+		}
+
+	if (normals != 0)
+		for (i=0; i<numCompactPoints; i++) {
+			double *n = normals->GetTuple(i);
+			for (k=0; k<3; k++)
+				normalArray[3*i+k] = static_cast<float>(n[k]);
+		}
+	else
+		computeNormals();
+
+	// Die Bounding-Box von VTK berechnen lassen
+	double b[6];
+	o->ComputeBounds();
+	o->GetBounds(b);
+	for (i=0; i<6; i++)
+		bbox[i] = static_cast<float>(b[i]);
+}
+
+int InterrogationObject::getNumberOfCompactPoints(void)
+{
+	return numCompactPoints;
+}
+
+int InterrogationObject::getNumberOfTriangles(void)
+{
+	return numTriangles;
+}
+
+float* InterrogationObject::getPointArray(void)
+{
+	return pointArray;
+}
+
+float* InterrogationObject::getNormalArray(void)
+{
+	return normalArray;
+}
+
+GLuint* InterrogationObject::getTriangleArray(void)
+{
+	return triangleArray;
+}
+
+long InterrogationObject::getMemorySize(void)
+{
+	long size = 3*numTriangles*sizeof(GLuint);
+
+	if (pointArray != 0)  size += 3*numCompactPoints*sizeof(float);
+	if (normalArray != 0) size += 3*numCompactPoints*sizeof(float);
+	if (compressed)
+		size += numCompactPoints*(3*sizeof(short) + sizeof(unsigned int) +
+		                          4*sizeof(GLbyte));
+	return size;
+}
+
+void InterrogationObject::compress(void)
+{
+	int i, k;
+	float n[3], len;
+
+	if (!compactMode || (pointArray == 0)) return;
+
+	delete [] quantizedPoints;
+	delete [] octNormals;
+	delete [] renderNormals;
+
+	computeQuantization(bbox, quantization);
+	quantizedPoints = new short[3*numCompactPoints];
+	octNormals      = new unsigned int[numCompactPoints];
+	renderNormals   = new GLbyte[4*numCompactPoints];
+
+	// die Buffer werden mit den komprimierten Arrays neu erzeugt
+	delete mesh;
+	mesh = 0;
+
+	for (i=0; i<numCompactPoints; i++) {
+		quantizePoint(pointArray+3*i, quantization, quantizedPoints+3*i);
+		octNormals[i] = encodeOctahedral(normalArray+3*i);
+
+		// Die Punkte werden mit der Skalierung der Quantisierung
+		// gezeichnet, OpenGL transformiert die Normalen mit der
+		// Inversen. Deshalb hier mit der Skalierung multiplizieren.
+		for (k=0; k<3; k++)
+			n[k] = normalArray[3*i+k]*quantization.scale[k];
+		len = sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2]);
+		if (len == 0.0f) len = 1.0f;
+		for (k=0; k<3; k++)
+			renderNormals[4*i+k] = static_cast<GLbyte>(floor(127.0f*n[k]/len + 0.5f));
+		renderNormals[4*i+3] = 0;
+	}
+	compressed = true;
+}
+
+void InterrogationObject::releaseFloatArrays(void)
+{
+	if (!compressed) return;
+
+	delete [] pointArray;
+	delete [] normalArray;
+	pointArray = normalArray = 0;
+}
+
+bool InterrogationObject::isCompressed(void)
+{
+	return compressed;
+}
+
+short* InterrogationObject::getQuantizedPoints(void)
+{
+	return quantizedPoints;
+}
+
+unsigned int* InterrogationObject::getOctahedralNormals(void)
+{
+	return octNormals;
+}
+
+const Quantization& InterrogationObject::getQuantization(void)
+{
+	return quantization;
+}
+
+void InterrogationObject::draw(void)
+{
+	bool culling;
+
+	if (!compactMode) {
+		setPointerAndDraw();
+		return;
+	}
+
+	if (mesh == 0) buildMesh();
+
+	// Die Chunks sind in Objektkoordinaten, die Sicht wird vor der
+	// Transformation der Quantisierung gelesen
+	culling = backFaceCulling && !chunkFirst.empty();
+	if (culling) selectChunks();
+
+	if (compressed) {
+		// p = offset + scale*q als Modelltransformation
+		glPushMatrix();
+		glTranslatef(quantization.offset[0], quantization.offset[1],
+		             quantization.offset[2]);
+		glScalef(quantization.scale[0], quantization.scale[1],
+		         quantization.scale[2]);
+		glEnable(GL_NORMALIZE);
+		drawTriangles(culling);
+		glDisable(GL_NORMALIZE);
+		glPopMatrix();
+		return;
+	}
+
+	drawTriangles(culling);
+}
+
+void InterrogationObject::pointsModified(int first, int n)
+{
+	if (mesh == 0) return;
+
+	chunksValid = false;
+	if (compressed) {
+		mesh->setPositions(first, n, quantizedPoints + 3*first);
+		mesh->setNormals(first, n, renderNormals + 4*first);
+	}
+	else {
+		mesh->setPositions(first, n, pointArray + 3*first);
+		mesh->setNormals(first, n, normalArray + 3*first);
+	}
+}
+
+MeshBuffer* InterrogationObject::getMeshBuffer(void)
+{
+	return mesh;
+}
+
+void InterrogationObject::setBackFaceCulling(bool b)
+{
+	backFaceCulling = b;
+	if (backFaceCulling && (mesh != 0) && chunkFirst.empty()) buildChunks();
+}
+
+bool InterrogationObject::getBackFaceCulling(void)
+{
+	return backFaceCulling;
+}
+
+unsigned int InterrogationObject::getDrawnTriangles(void)
+{
+	return drawnTriangles;
+}
+
+unsigned int InterrogationObject::getBackFacingTriangles(void)
+{
+	return backFacingTriangles;
+}
+
+void InterrogationObject::resetStatistics(void)
+{
+	drawnTriangles = backFacingTriangles = 0;
+}
+
+// Die gepackten Arrays werden einmal in die Buffer kopiert, danach
+// nur noch die geaenderten Punkte
+void InterrogationObject::buildMesh(void)
+{
+	mesh = new MeshBuffer(MeshBuffer::Normals |
+	                      (compressed ? MeshBuffer::Quantized : 0));
+	mesh->setNumberOfVertices(numCompactPoints);
+	mesh->setIndices(triangleArray, 3*numTriangles);
+	pointsModified(0, numCompactPoints);
+
+	chunkFirst.clear();
+	chunkCount.clear();
+	if (backFaceCulling) buildChunks();
+}
+
+// Die Dreiecke werden nach ihrem Schwerpunkt in ein Gitter ueber der
+// Bounding-Box einsortiert (Counting Sort), jeder Chunk ist danach ein
+// zusammenhaengender Bereich der Indizes im MeshBuffer
+void InterrogationObject::buildChunks(void)
+{
+	int t, k, c, cell[3], numCells = chunkResolution*chunkResolution*chunkResolution;
+	float p[3], m[3], size[3];
+	vector<int> cellOf(numTriangles), start(numCells+1, 0);
+	vector<GLuint> indices(3*numTriangles);
+
+	chunkFirst.clear();
+	chunkCount.clear();
+	if (numTriangles == 0) return;
+
+	for (k=0; k<3; k++) size[k] = bbox[2*k+1]-bbox[2*k];
+	for (t=0; t<numTriangles; t++) {
+		m[0] = m[1] = m[2] = 0.0f;
+		for (c=0; c<3; c++) {
+			compactPoint(triangleArray[3*t+c], p);
+			for (k=0; k<3; k++) m[k] += p[k]/3.0f;
+		}
+		for (k=0; k<3; k++) {
+			cell[k] = (size[k] > 0.0f) ? (int) (chunkResolution*(m[k]-bbox[2*k])/size[k]) : 0;
+			if (cell[k] < 0) cell[k] = 0;
+			if (cell[k] >= chunkResolution) cell[k] = chunkResolution-1;
+		}
+		cellOf[t] = cell[0] + chunkResolution*(cell[1] + chunkResolution*cell[2]);
+		start[cellOf[t]+1]++;
+	}
+	for (c=0; c<numCells; c++) start[c+1] += start[c];
+
+	vector<int> fill(start.begin(), start.end()-1);
+	for (t=0; t<numTriangles; t++) {
+		for (k=0; k<3; k++)
+			indices[3*fill[cellOf[t]]+k] = triangleArray[3*t+k];
+		fill[cellOf[t]]++;
+	}
+	for (c=0; c<numCells; c++) {
+		if (start[c] == start[c+1]) continue;
+		chunkFirst.push_back(3*start[c]);
+		chunkCount.push_back(3*(start[c+1]-start[c]));
+	}
+	mesh->setIndices(&indices[0], indices.size());
+	chunksValid = false;
+}
+
+// Die Normalen der Kegel sind die Normalen der Dreiecke, wie bei
+// GL_CULL_FACE und nicht die gemittelten Normalen der Punkte
+void InterrogationObject::updateChunks(void)
+{
+	int c, i, j, k;
+	float p[3][3], box[6], e1[3], e2[3];
+	vector<float> normals;
+
+	chunkBoxes.resize(6*chunkFirst.size());
+	chunkCones.resize(chunkFirst.size());
+	for (c=0; c<(int) chunkFirst.size(); c++) {
+		normals.clear();
+		compactPoint(mesh->getIndex(chunkFirst[c]), p[0]);
+		for (k=0; k<3; k++) box[2*k] = box[2*k+1] = p[0][k];
+		for (i=chunkFirst[c]; i<chunkFirst[c]+chunkCount[c]; i+=3) {
+			for (j=0; j<3; j++) {
+				compactPoint(mesh->getIndex(i+j), p[j]);
+				for (k=0; k<3; k++) {
+					if (p[j][k] < box[2*k])   box[2*k]   = p[j][k];
+					if (p[j][k] > box[2*k+1]) box[2*k+1] = p[j][k];
+				}
+			}
+			for (k=0; k<3; k++) {
+				e1[k] = p[1][k]-p[0][k];
+				e2[k] = p[2][k]-p[0][k];
+			}
+			normals.push_back(e1[1]*e2[2]-e1[2]*e2[1]);
+			normals.push_back(e1[2]*e2[0]-e1[0]*e2[2]);
+			normals.push_back(e1[0]*e2[1]-e1[1]*e2[0]);
+		}
+		for (k=0; k<6; k++) chunkBoxes[6*c+k] = box[k];
+		chunkCones[c].build(normals);
+	}
+	chunksValid = true;
+}
+
+// Benachbarte Chunks werden zu einem Bereich zusammengefasst
+void InterrogationObject::selectChunks(void)
+{
+	int c;
+	const float *box;
+
+	if (!chunksValid) updateChunks();
+
+	view.read();
+	drawFirst.clear();
+	drawCount.clear();
+	for (c=0; c<(int) chunkFirst.size(); c++) {
+		box = &chunkBoxes[6*c];
+		if (view.isOutside(box)) continue;
+		if (chunkCones[c].isBackFacing(view, box)) {
+			backFacingTriangles += chunkCount[c]/3;
+			continue;
+		}
+		drawnTriangles += chunkCount[c]/3;
+		if (!drawFirst.empty() && drawFirst.back()+drawCount.back() == chunkFirst[c])
+			drawCount.back() += chunkCount[c];
+		else {
+			drawFirst.push_back(chunkFirst[c]);
+			drawCount.push_back(chunkCount[c]);
+		}
+	}
+}
+
+void InterrogationObject::drawTriangles(bool culling)
+{
+	if (!culling) {
+		mesh->draw(GL_TRIANGLES);
+		drawnTriangles += numTriangles;
+	}
+	else if (!drawFirst.empty())
+		mesh->drawRanges(GL_TRIANGLES, &drawFirst[0], &drawCount[0], drawFirst.size());
+}
+
+void InterrogationObject::compactPoint(int i, float p[3])
+{
+	if (pointArray != 0) {
+		p[0] = pointArray[3*i];
+		p[1] = pointArray[3*i+1];
+		p[2] = pointArray[3*i+2];
+	}
+	else
+		dequantizePoint(quantizedPoints + 3*i, quantization, p);
+}
+
+// Normalen als Summe der Dreiecksnormalen, gewichtet mit der Flaeche
+void InterrogationObject::computeNormals(void)
+{
+	int i, k;
+	float e1[3], e2[3], n[3], len;
+
+	for (i=0; i<3*numCompactPoints; i++) normalArray[i] = 0.0f;
+
+	for (i=0; i<numTriangles; i++) {
+		float *p0 = pointArray + 3*triangleArray[3*i],
+		      *p1 = pointArray + 3*triangleArray[3*i+1],
+		      *p2 = pointArray + 3*triangleArray[3*i+2];
+		for (k=0; k<3; k++) {
+			e1[k] = p1[k]-p0[k];
+			e2[k] = p2[k]-p0[k];
+		}
+		n[0] = e1[1]*e2[2]-e1[2]*e2[1];
+		n[1] = e1[2]*e2[0]-e1[0]*e2[2];
+		n[2] = e1[0]*e2[1]-e1[1]*e2[0];
+		for (k=0; k<3; k++) {
+			normalArray[3*triangleArray[3*i]+k]   += n[k];
+			normalArray[3*triangleArray[3*i+1]+k] += n[k];
+			normalArray[3*triangleArray[3*i+2]+k] += n[k];
+		}
+	}
+
+	for (i=0; i<numCompactPoints; i++) {
+		float *m = normalArray + 3*i;
+		len = sqrt(m[0]*m[0]+m[1]*m[1]+m[2]*m[2]);
+		if (len > 0.0f) {
+			m[0] /= len; m[1] /= len; m[2] /= len;
+		}
+	}
+}
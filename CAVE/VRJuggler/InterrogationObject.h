@@ -12,6 +12,13 @@
 #include "vlgGetVTKPolyData.h"
 #include "vlgTextureMap2D.h"
 #include <vtkPolyData.h>
+#include <GL/glu.h>
+
+#include <vector>
+
+#include "ScalarKernels.h"
+#include "MeshBuffer.h"
+#include "NormalCone.h"
 
 //! Klasse fr das Darstellen und Handeln des untersuchten geometrischen Objekts
 class InterrogationObject : public vlgGetVTKPolyData
@@ -20,7 +27,13 @@ public:
      //! Default-Konstructor
      InterrogationObject(void);
      //! Kopierkonstructor
+     /*!
+       Kopiert auch die gepackten und komprimierten Arrays, der
+       MeshBuffer wird beim ersten draw() neu angelegt.
+     */
      InterrogationObject(const InterrogationObject&);
+     //! Destruktor
+     ~InterrogationObject(void);
      //! Konstruktor, der ein VTK-File einliest
      /*!
        Der Konstruktor verwendet ein polygonales Netz, das aus
@@ -39,6 +52,13 @@ public:
        The render color of the object is set to red.
      */
      InterrogationObject(char*);
+     //! Constructor based on a vtk file, in compact mode or not
+     /*!
+       The mode is set before the file is read, so in compact mode no
+       vtkPolyData is built besides the output of the reader, see
+       setCompactMode(). The second argument is the texture state.
+     */
+     InterrogationObject(char*, bool, bool);
      
      //! Read the polygonal data from a file in VTK format 
      void readObject(char*);
@@ -77,6 +97,95 @@ public:
      
      //! set the polygonal data to vtkPolyData
      void setObject(vtkPolyData *o);
+
+     //! Switch the compact mode on or off
+     /*!
+       In compact mode the polygonal data is converted into packed arrays
+       after reading: 3 floats for the point, 3 floats for the normal of
+       every vertex, and 3 indices for every triangle. Polygons and
+       triangle strips are triangulated. The VTK reader and the
+       vtkPolyData are deleted after the conversion, so getVTKData()
+       gives back NULL. The arrays are used for the computation of the
+       interrogation lines and for the rendering with draw().
+
+       The mode has to be set before the object is read, or given to
+       the constructor reading the file. Default is off.
+     */
+     void setCompactMode(bool c);
+     //! Query the compact mode
+     bool getCompactMode(void);
+     //! Convert polygonal data into the packed arrays
+     void compact(vtkPolyData*);
+
+     //! Query the number of points in compact mode
+     int     getNumberOfCompactPoints(void);
+     //! Query the number of triangles in compact mode
+     int     getNumberOfTriangles(void);
+     //! Query the packed points in compact mode
+     float*  getPointArray(void);
+     //! Query the packed normals in compact mode
+     float*  getNormalArray(void);
+     //! Query the triangle indices in compact mode
+     GLuint* getTriangleArray(void);
+     //! Query the memory used by the packed arrays in bytes
+     long    getMemorySize(void);
+
+     //! Compress the packed arrays
+     /*!
+       The points are quantized to 16 bit relative to the bounding box,
+       the normals are encoded in 32 bit with the octahedral mapping. For
+       the rendering the normals are also stored as bytes. That is
+       14 instead of 24 bytes for every vertex.
+
+       The float arrays are kept until releaseFloatArrays() is called,
+       so the precision can be compared.
+     */
+     void compress(void);
+     //! Delete the float arrays of the compact mode after compress()
+     void releaseFloatArrays(void);
+     //! Query, if the compressed arrays are used
+     bool isCompressed(void);
+     //! Query the quantized points
+     short*        getQuantizedPoints(void);
+     //! Query the normals in octahedral encoding
+     unsigned int* getOctahedralNormals(void);
+     //! Query the quantization of the points
+     const Quantization& getQuantization(void);
+
+     //! Render the object
+     /*!
+       In compact mode the packed arrays are copied into a MeshBuffer
+       with the first call, the compressed arrays if compress() was
+       called. The buffer is rendered with glDrawElements. Otherwise
+       setPointerAndDraw() is called.
+     */
+     void draw(void);
+     //! The packed arrays of n points, starting at first, have changed
+     /*!
+       Only these points and normals are copied into the MeshBuffer and
+       uploaded with the next draw().
+     */
+     void pointsModified(int first, int n);
+     //! Query the MeshBuffer of the compact mode, NULL before the first draw()
+     MeshBuffer* getMeshBuffer(void);
+
+     //! Skip the invisible and the back facing parts in compact mode
+     /*!
+       The triangles are sorted into chunks of a uniform grid over the
+       bounding box, every chunk gets a bounding box and a NormalCone
+       of its triangles. draw() skips the chunks outside of the view
+       and the back facing chunks. Counterclockwise triangles are front
+       facing, like with glFrontFace(GL_CCW). Default is off.
+     */
+     void setBackFaceCulling(bool);
+     //! Are the invisible and the back facing parts skipped?
+     bool getBackFaceCulling(void);
+     //! Query the triangles drawn since the last resetStatistics()
+     unsigned int getDrawnTriangles(void);
+     //! Query the triangles in the view skipped as back facing
+     unsigned int getBackFacingTriangles(void);
+     //! Set the counters to 0
+     void resetStatistics(void);
      
      
 private:
@@ -88,5 +197,64 @@ private:
      bool textured;
      //! Instanz einer 2D Textur fr die Ausgabe als Textur
      vlgTextureMap2D *texture;
+
+     //! Compact mode, VTK data is deleted after reading
+     bool compactMode;
+     //! Number of points and triangles in compact mode
+     int numCompactPoints, numTriangles;
+     //! Packed points, 3 floats for every point
+     float *pointArray;
+     //! Packed normals, 3 floats for every point
+     float *normalArray;
+     //! Triangle indices, 3 for every triangle
+     GLuint *triangleArray;
+     //! Compressed arrays are used
+     bool compressed;
+     //! Quantization of the points
+     Quantization quantization;
+     //! Quantized points, 3 shorts for every point
+     short *quantizedPoints;
+     //! Normals in octahedral encoding
+     unsigned int *octNormals;
+     //! Normals for the rendering, 4 bytes for every point
+     GLbyte *renderNormals;
+     //! Packed arrays for the rendering in buffer objects
+     MeshBuffer *mesh;
+
+     //! Skip the invisible and back facing chunks?
+     bool backFaceCulling;
+     //! Bounding boxes of the chunks, 6 floats each
+     vector<float> chunkBoxes;
+     //! Normal cones of the chunks
+     vector<NormalCone> chunkCones;
+     //! First index and number of indices of the chunks in the MeshBuffer
+     vector<int> chunkFirst, chunkCount;
+     //! Are the boxes and the cones valid for the points?
+     bool chunksValid;
+     //! The view of the last draw()
+     ViewFrustum view;
+     //! Ranges of the draw call, kept to avoid allocation
+     vector<int> drawFirst, drawCount;
+     //! Counters
+     unsigned int drawnTriangles, backFacingTriangles;
+
+     // shared initialization of the constructors
+     void init(void);
+     // no assignment, the arrays are owned by the object
+     InterrogationObject& operator=(const InterrogationObject&);
+     // normals averaged from the triangles, if the data has no normals
+     void computeNormals(void);
+     // copy the packed arrays into the mesh buffer
+     void buildMesh(void);
+     // sort the triangles of the mesh buffer into chunks
+     void buildChunks(void);
+     // bounding boxes and normal cones of the chunks for the points
+     void updateChunks(void);
+     // the visible chunks for the current view
+     void selectChunks(void);
+     // render all triangles or the visible chunks
+     void drawTriangles(bool culling);
+     // point i of the packed or quantized points
+     void compactPoint(int i, float p[3]);
 };
 #endif
@@ -15,6 +15,9 @@
 #include <vtkPointData.h>
 #include <vtkContourFilter.h>
 
+#include <math.h>
+#include "ScalarKernels.h"
+
 Isophotes::Isophotes(void)
 {
    radius = 0.0; numLines = 1;
@@ -119,6 +122,12 @@ void Isophotes::compute(void)
    double range[2];
    list<LightLine>::iterator iter = NULL; // only dummy, but we need it.
 
+   // compact mode: no VTK data available
+   if (surfaceNet->getCompactMode()) {
+      computeCompact();
+      return;
+   }
+
    vtkFloatArray *highlightNumbers = vtkFloatArray::New();
    vtkContourFilter *iso = vtkContourFilter::New();
    vlgGetVTKPolyData *result;
@@ -162,6 +171,69 @@ void Isophotes::compute(void)
    highlightNumbers->Delete();
 }
 
+void Isophotes::computeCompact(void)
+{
+   int noP = surfaceNet->getNumberOfCompactPoints();
+   float range[2], *normals = surfaceNet->getNormalArray();
+
+   if (numLines>1) {
+      range[0] = -1.0f; range[1] = 1.0f;
+      contourEngine->generateValues(numLines, range);
+   }
+   else
+      contourEngine->setValue(0.0f);
+
+   // getDirection() gives back a new array
+   float *d = direction->getDirection();
+   compactScalars.resize(noP);
+   if (noP > 0) {
+      if (surfaceNet->isCompressed())
+         isophoteValues(surfaceNet->getOctahedralNormals(), noP, d, &compactScalars[0]);
+      else
+         isophoteValues(normals, noP, d, &compactScalars[0]);
+   }
+   delete [] d;
+
+   contourCompact();
+}
+
+void Isophotes::compareCompression(ostream &out)
+{
+   int i, noP = surfaceNet->getNumberOfCompactPoints(), changed;
+   float maxError, meanError, diagonal, box[6];
+   float *normals = surfaceNet->getNormalArray(),
+         *points = surfaceNet->getPointArray();
+
+   if (!surfaceNet->isCompressed() || (points == 0) || (normals == 0) || (noP == 0)) {
+      out << "Isophotes::compareCompression: no float arrays" << endl;
+      return;
+   }
+
+   float *d = direction->getDirection();
+   vector<float> reference(noP), scalars(noP), decoded(3*noP);
+   isophoteValues(normals, noP, d, &reference[0]);
+   isophoteValues(surfaceNet->getOctahedralNormals(), noP, d, &scalars[0]);
+   delete [] d;
+   for (i=0; i<noP; i++)
+       dequantizePoint(surfaceNet->getQuantizedPoints()+3*i,
+                       surfaceNet->getQuantization(), &decoded[3*i]);
+
+   contourEngine->compare(points, &decoded[0], surfaceNet->getTriangleArray(),
+                          surfaceNet->getNumberOfTriangles(),
+                          &reference[0], &scalars[0],
+                          maxError, meanError, changed);
+
+   surfaceNet->getBoundingBox(box);
+   diagonal = sqrt((box[1]-box[0])*(box[1]-box[0]) + (box[3]-box[2])*(box[3]-box[2]) +
+                   (box[5]-box[4])*(box[5]-box[4]));
+   if (diagonal == 0.0f) diagonal = 1.0f;
+
+   out << "Compressed isophotes: max. error " << maxError
+       << " (" << maxError/diagonal << " of the diagonal), mean error "
+       << meanError << " (" << meanError/diagonal << "), "
+       << changed << " edge crossings changed" << endl;
+}
+
 // Remember, that the size in int has to be a power of 2!
 //
 // No prefiltering is done for that pixel.
@@ -198,24 +270,28 @@ void Isophotes::computeTextureCoordinates(void)
 
 }
 
+// One texel of the prefiltered image from sub=4 texels of the big
+// image, stride apart. The weights sum up to 6; accumulate in an int,
+// 6*65535 does not fit into an unsigned short.
+static unsigned short filterTexel(const unsigned short *big, int stride)
+{
+   static const unsigned int filterKernel[4] = {1,2,2,1};
+   unsigned int k, sample = 0;
+
+   for (k=0; k<4; k++)
+       sample += filterKernel[k]*big[k*stride];
+   return sample/6;
+}
+
 void Isophotes::preFilter(int vh, int size, 
                           unsigned short *bigImage,
                           unsigned short *smallImage)
 {
-   int i, j, l, sub=4;
-   unsigned short sample, weightSum=4;
-
-   unsigned short filterKernel[4] = {1,2,2,1};
+   int i, j, sub=4;
 
    // Integrate for the first row, then copy
-   for (j=0; j< size; j++) {
-       sample = 0;
-       // Supersample
-       for (l=j*sub; l<(j+1)*sub; l++) {
-            sample += filterKernel[l-j*sub]*bigImage[l*vh];
-       }
-       smallImage[j*vh] = sample/weightSum;
-   }
+   for (j=0; j< size; j++)
+       smallImage[j*vh] = filterTexel(bigImage + j*sub*vh, vh);
 
    // copy the first row to the rest
    for (i=1; i<vh; i++)
@@ -227,17 +303,8 @@ void Isophotes::preFilter(int size,
                           unsigned short *bigImage,
                           unsigned short *smallImage)
 {
-   int i, k, sub=4;
-   unsigned short sample, weightSum=4;
-
-   unsigned short filterKernel[4] = {1,2,2,1};
-
-   for (i=0; i< size; i++) {
-       sample = 0;
-       // Supersample
-       for (k=i*sub; k<(i+1)*sub; k++) {
-            sample += filterKernel[k-i*sub]*bigImage[k];
-       }
-       smallImage[i] = sample/weightSum;
-   }
+   int i, sub=4;
+
+   for (i=0; i< size; i++)
+       smallImage[i] = filterTexel(bigImage + i*sub, 1);
 }
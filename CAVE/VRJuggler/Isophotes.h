@@ -12,6 +12,7 @@
 #define ISOPHOTES
 
 #include <list>
+#include <iostream>
 #include <vtkFloatArray.h>
 #include <vtkStructuredPoints.h>
 #include "vlgTextureMap1D.h"
@@ -85,6 +86,15 @@ public:
    */
    virtual void       computeTextureCoordinates(void);
 
+   //! Compare the isophotes of the compressed and the float arrays
+   /*!
+     The interrogated object has to be compressed, and the float arrays
+     must not be released. The distances of the isophotes on the edges
+     of the mesh are printed, absolute and relative to the diagonal of
+     the bounding box.
+   */
+   void compareCompression(ostream&);
+
 private:
    //! Compute the scalars to contour
    /*!
@@ -95,6 +105,15 @@ private:
    */
    virtual void computeScalars(vtkFloatArray*, list<LightLine>::iterator); 
 
+   //! Compute the isophotes in compact mode
+   /*!
+     The scalars are computed for the packed normals of the interrogated
+     object and contoured with the \link ContourEngine \endlink. No
+     VTK object is used. For a compressed object the octahedral normals
+     are decoded in the kernel.
+   */
+   void computeCompact(void);
+
    // preFilter for 2D (saveTextures computes 2D!
    void preFilter(int vh, int size, unsigned short *bigImage, 
                                     unsigned short *smallImage);
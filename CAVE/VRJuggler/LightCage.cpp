@@ -2,7 +2,7 @@
 //  LightCage.C
 //  
 //  Implementation file:
-//  A STL container (list) for LightLines
+//  Contiguous arrays for the lines of a cage
 // --------------------------------------------------------------------
 //  $RCSfile$
 //  $Revision$
@@ -13,24 +13,34 @@
 #include <GL/glu.h>
 #include "LightLine.h"
 #include "LightCage.h"
+#include "LightForms.h"
 
 using namespace std;
 
+LightCage::LightCage(void)
+{
+   radius = 0.0f;
+   attenuation = LightLine::Constant;
+   preFilterMap = false;
+   color[0] = color[1] = color[2] = 1.0f;
+   revision = 1;
+   viewRevision = 0;
+   viewShared = false;
+}
+
 // The next two functions can be used to set the attenuation of the
 // lightlines. No inhomogenous lightcages with concern of the
 // attenuation are supported. Maybe in the future.
 void   LightCage::setCageAttenuation(LightLine::Attenuation att)
 {
-   list<LightLine>::iterator iter= cage.begin();
-   list<LightLine>::iterator end = cage.end();
+   unsigned int i;
 
+   writeBack();
    attenuation = att;
 
-// Iterate through the lines and set the requested attenuation
-   while (iter != end) {
-      iter->setAttenuation(att);
-      ++iter;
-   }
+   for (i=0; i<attenuations.size(); i++)
+      attenuations[i] = att;
+   modified();
 }
 
 void   LightCage::setAttenuation(LightLine::Attenuation att)
@@ -46,28 +56,30 @@ LightLine::Attenuation LightCage::getAttenuation(void)
 // List functions
 bool  LightCage::empty(void)
 {
-   return cage.empty();
+   return radii.empty();
 }
 
 // push of LightLine on LightCage
-// line is pushed as is, no check on attributes, so 
-// this way we could possibly get inhomomgenous attributes!
+// Radius and attenuation of the cage overwrite the attributes of the
+// line, the color of the line is kept.
 void  LightCage::pushback(LightLine line) 
 {
-   line.setAttenuation(attenuation);
-   line.setRadius(radius);
-   cage.push_back(line);
+   float p[3], d[3], c[3];
+
+   line.getPoint(p);
+   line.getDirection(d);
+   line.getColor(c);
+   addLine(p, d, radius, attenuation, line.getLength(), line.getCylinder(), c);
 }
 
-void  LightCage::pushback(float *p, float *d, float l)
+void  LightCage::pushback(float *p, float *d)
 {
-   // construct the LightLine and insert
-   float r = 0.0f;
-   LightLine *line = new LightLine(p,d,r,l);
-   line->setAttenuation(attenuation);
-   line->setRadius(radius);
+   addLine(p, d, radius, attenuation, 1.0f, false, color);
+}
 
-   cage.push_back(*line);
+void  LightCage::pushback(float *p, float *d, float l)
+{
+   addLine(p, d, radius, attenuation, l, false, color);
 }
 
 // Iterate through the lines, compute scalar values for every line
@@ -75,16 +87,21 @@ void  LightCage::pushback(float *p, float *d, float l)
 // perpendicular distance
 void LightCage::computeScalar(float values[], float point[3], float normal[3])
 {
-   int i=0;
-   list<LightLine>::iterator iter;
-   list<LightLine>::iterator end = cage.end();
-   // Iterate through the lines, compute scalar values for every line
-   // and return the minimum value!
-
-   iter = cage.begin();
-   while (iter != end) {
-      values[i] = iter->highlightValue(point,normal);
-      ++iter; ++i;
+   int i, n = size();
+   const float *p, *d;
+   float len, s[3], h[3];
+
+   // normalize the surface normal only once for all lines
+   len = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+   s[0] = normal[0]/len; s[1] = normal[1]/len; s[2] = normal[2]/len;
+
+   for (i=0; i<n; i++) {
+       p = &points[3*i]; d = &directions[3*i];
+       // perpendicular distance (d x s).(p - point)
+       h[0] = d[1]*s[2] - d[2]*s[1];
+       h[1] = d[2]*s[0] - d[0]*s[2];
+       h[2] = d[0]*s[1] - d[1]*s[0];
+       values[i] = h[0]*(p[0]-point[0]) + h[1]*(p[1]-point[1]) + h[2]*(p[2]-point[2]);
    }
 }
 
@@ -92,10 +109,8 @@ void LightCage::computeScalar(float values[], float point[3], float normal[3])
 // isophotes; only one light line!
 void LightCage::computeScalar(float &value, float normal[3])
 {
-   list<LightLine>::iterator iter;
-
-   iter = cage.begin();
-      value = iter->isophoteValue(normal);
+   value = directions[0]*normal[0] + directions[1]*normal[1] 
+         + directions[2]*normal[2];
 }
 
 // overloaded computeScalar
@@ -103,31 +118,59 @@ void LightCage::computeScalar(float &value, float normal[3])
 void LightCage::computeScalar(float values[], float point[3], 
                                  float normal[3], float eye[3])
 {
-   int i=0;
-   list<LightLine>::iterator iter;
-   list<LightLine>::iterator end = cage.end();
-// Iterate through the lines, compute scalar values for every line
-// and return the minimum value!
-
-   iter = cage.begin();
-   while (iter != end) {
-      values[i] = iter->reflectionValue(point,normal, eye);
-      ++iter; ++i;
+   int i, n = size();
+   const float *p, *d;
+   float lambda, len, r[3], h[3];
+
+   // the reflected ray does not depend on the line
+   r[0] = eye[0]-point[0]; r[1] = eye[1]-point[1]; r[2] = eye[2]-point[2];
+   lambda = 2.0f*(normal[0]*r[0] + normal[1]*r[1] + normal[2]*r[2]);
+   r[0] = lambda*normal[0] - r[0];
+   r[1] = lambda*normal[1] - r[1];
+   r[2] = lambda*normal[2] - r[2];
+   len = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+   r[0] /= len; r[1] /= len; r[2] /= len;
+
+   for (i=0; i<n; i++) {
+       p = &points[3*i]; d = &directions[3*i];
+       h[0] = d[1]*r[2] - d[2]*r[1];
+       h[1] = d[2]*r[0] - d[0]*r[2];
+       h[2] = d[0]*r[1] - d[1]*r[0];
+       values[i] = h[0]*(p[0]-point[0]) + h[1]*(p[1]-point[1]) + h[2]*(p[2]-point[2]);
    }
 }
 
 // render with OpenGL
 void  LightCage::draw(void)
 {
-   list<LightLine>::iterator iter;
-   list<LightLine>::iterator end = cage.end();
-
-   iter = cage.begin();
-
-   while (iter != end) {
-      iter->draw();
-      ++iter;
+   int i, n = size();
+   const float *p, *d;
+   GLUquadricObj *cyl = NULL;
+
+   // all lines in one glBegin/glEnd
+   glBegin(GL_LINES);
+   for (i=0; i<n; i++) {
+       if (cylinders[i]) continue;
+       p = &points[3*i]; d = &directions[3*i];
+       glColor3fv(&colors[3*i]);
+       glVertex3fv(p);
+       glVertex3f(p[0]+lengths[i]*d[0], p[1]+lengths[i]*d[1], 
+                  p[2]+lengths[i]*d[2]);
+   }
+   glEnd();
+
+   for (i=0; i<n; i++) {
+       if (!cylinders[i]) continue;
+       if (cyl == NULL) {
+          cyl = gluNewQuadric();
+          gluQuadricNormals(cyl, GLU_SMOOTH);
+          gluQuadricDrawStyle(cyl, GLU_FILL);
+       }
+       glColor3fv(&colors[3*i]);
+       LightLine::drawCylinder(cyl, &points[3*i], &directions[3*i],
+                               radii[i], lengths[i]);
    }
+   if (cyl != NULL) gluDeleteQuadric(cyl);
 }
 
 // get the cage as a OpenGL Display List
@@ -135,15 +178,7 @@ GLuint LightCage::createList(void)
 {
    GLuint group = glGenLists(1);
 
-   list<LightLine>::iterator iter = cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   glNewList(group, GL_COMPILE);
-   while (iter != end) {
-      iter->draw();
-      ++iter;
-   }
-   glEndList();
+   createList(group);
 
    return group;
 }
@@ -151,42 +186,39 @@ GLuint LightCage::createList(void)
 // add the cage geometry to a empty, existing display list
 void LightCage::createList(GLuint group)
 {
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
    glNewList(group, GL_COMPILE);
-   while (iter != end) {
-      iter->draw();
-      ++iter;
-   }
+   draw();
    glEndList();
 }
 
 LightLine& LightCage::front(void)
 {
-   return cage.front();
+   updateView();
+   viewShared = true;
+   return view.front();
 }
 LightLine& LightCage::back(void)
 {
-   return cage.back();
+   updateView();
+   viewShared = true;
+   return view.back();
 }
 
 int LightCage::size(void)
 {
-   return cage.size();
+   return radii.size();
 }
 
 void LightCage::setCageRadius(float r)
 {
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
+   unsigned int i;
 
+   writeBack();
    radius = r;
 
-   while (iter != end) {
-      iter->setRadius(r);
-      ++iter;
-   }
+   for (i=0; i<radii.size(); i++)
+      radii[i] = r;
+   modified();
 }
 
 void LightCage::setRadius(float r)
@@ -201,32 +233,180 @@ float LightCage::getRadius(void)
 
 void LightCage::setColor(float c[3])
 {
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   while (iter != end) {
-      iter->setColor(c);
-      ++iter;
-   }
+   setColor(c[0], c[1], c[2]);
 }
 
 void LightCage::setColor(float r, float g, float b)
 {
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
+   unsigned int i;
+
+   writeBack();
+   color[0] = r; color[1] = g; color[2] = b;
 
-   while (iter != end) {
-      iter->setColor(r,g,b);
-      ++iter;
+   for (i=0; i<colors.size(); i+=3) {
+      colors[i] = r; colors[i+1] = g; colors[i+2] = b;
    }
+   modified();
 }
 
 list<LightLine>::iterator LightCage::begin(void)
 {
-   return cage.begin();
+   updateView();
+   viewShared = true;
+   return view.begin();
 }
 
 list<LightLine>::iterator LightCage::end(void)
 {
-   return cage.end();
+   updateView();
+   viewShared = true;
+   return view.end();
+}
+
+//
+// protected
+//
+void LightCage::copyCage(const LightCage &copy)
+{
+   points = copy.points;
+   directions = copy.directions;
+   radii = copy.radii;
+   attenuations = copy.attenuations;
+   lengths = copy.lengths;
+   cylinders = copy.cylinders;
+   colors = copy.colors;
+   color[0] = copy.color[0]; color[1] = copy.color[1]; color[2] = copy.color[2];
+
+   radius = copy.radius;
+   attenuation = copy.attenuation;
+   preFilterMap = copy.preFilterMap;
+
+   // the view is built again, if it is needed
+   view.clear();
+   viewShared = false;
+   modified();
+}
+
+void LightCage::addLine(const float p[3], const float d[3], float r,
+                        LightLine::Attenuation a, float l, bool c,
+                        const float rgb[3])
+{
+   float len = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+
+   writeBack();
+   points.insert(points.end(), p, p+3);
+   // the scalars are distances only for a unit direction, like LightLine
+   if (len > 0.0f) {
+      directions.push_back(d[0]/len);
+      directions.push_back(d[1]/len);
+      directions.push_back(d[2]/len);
+   }
+   else
+      directions.insert(directions.end(), d, d+3);
+   radii.push_back(r);
+   attenuations.push_back(a);
+   lengths.push_back(l);
+   cylinders.push_back(c);
+   colors.insert(colors.end(), rgb, rgb+3);
+   modified();
+}
+
+void LightCage::updateView(void)
+{
+   int i, n = size();
+
+   if (viewRevision == revision) return;
+
+   view.clear();
+   for (i=0; i<n; i++) {
+       LightLine line(&points[3*i], &directions[3*i], radii[i], 
+                      attenuations[i], lengths[i]);
+       line.setCylinder(cylinders[i]);
+       line.setColor(&colors[3*i]);
+       view.push_back(line);
+   }
+   viewRevision = revision;
+   viewShared = false;
+}
+
+// The copy is compared with the arrays, only a changed copy changes
+// the revision. A copy out of date was replaced by a change of the
+// arrays, its iterators are invalid.
+void LightCage::writeBack(void)
+{
+   int i, k;
+   float p[3], d[3], c[3];
+   bool changed = false;
+   list<LightLine>::iterator line;
+
+   if (!viewShared || (viewRevision != revision)) return;
+
+   for (i=0, line=view.begin(); line!=view.end(); ++line, i++) {
+       line->getPoint(p);
+       line->getDirection(d);
+       line->getColor(c);
+       for (k=0; k<3; k++) {
+           if (points[3*i+k] != p[k])     {points[3*i+k] = p[k];     changed = true;}
+           if (directions[3*i+k] != d[k]) {directions[3*i+k] = d[k]; changed = true;}
+           if (colors[3*i+k] != c[k])     {colors[3*i+k] = c[k];     changed = true;}
+       }
+       if (radii[i] != line->getRadius())             {radii[i] = line->getRadius();             changed = true;}
+       if (attenuations[i] != line->getAttenuation()) {attenuations[i] = line->getAttenuation(); changed = true;}
+       if (lengths[i] != line->getLength())           {lengths[i] = line->getLength();           changed = true;}
+       if (cylinders[i] != line->getCylinder())       {cylinders[i] = line->getCylinder();       changed = true;}
+   }
+   // the copy is still valid for the iterators
+   if (changed) {
+      modified();
+      viewRevision = revision;
+   }
+}
+
+// The light forms are shared with the CAVELib version
+float LightCage::attenuate(double pD, LightLine::Attenuation a)
+{
+   return static_cast<float>(lightForm(pD, a));
+}
+
+double LightCage::integrate(double t, LightLine::Attenuation a)
+{
+   return lightFormIntegral(t, a);
+}
+
+float LightCage::boxFilter(double a, double b, LightLine::Attenuation form)
+{
+   return static_cast<float>(lightFormBoxFilter(a, b, form));
+}
+
+void LightCage::translateLines(float x, float y, float z)
+{
+   int i, n = size();
+
+   writeBack();
+   // translating the lines means changing the points only
+   for (i=0; i<n; i++) {
+       points[3*i]   += x;
+       points[3*i+1] += y;
+       points[3*i+2] += z;
+   }
+   modified();
+}
+
+void LightCage::rotateLines(int axis, float degrees)
+{
+   int i, n = size();
+   Vector3 d;
+
+   writeBack();
+   // rotate only the directions
+   for (i=0; i<n; i++) {
+       d.set(directions[3*i], directions[3*i+1], directions[3*i+2]);
+       if (axis == 0)      d.rotateX(degrees);
+       else if (axis == 1) d.rotateY(degrees);
+       else                d.rotateZ(degrees);
+       directions[3*i]   = d.getX();
+       directions[3*i+1] = d.getY();
+       directions[3*i+2] = d.getZ();
+   }
+   modified();
 }
@@ -10,6 +10,7 @@
 #define LIGHTCAGE
 
 #include <list>
+#include <vector>
 
 #include "vlgTextureMap1D.h"
 #include "LightLine.h"
@@ -22,6 +23,16 @@ using namespace std;
   A class representing a set of light lines or cylinders, called a light cage.
   The main purpose of this class is to present an interface to the light lines
   and to manage homogenous attributes. 
+
+  The lines are stored as contiguous arrays, one entry for every line:
+  points, directions and colors with 3 floats, radius, attenuation,
+  render length and the cylinder flag. The index of a line is the order
+  of insertion and does not change. The scalar and luminance loops work
+  on these arrays. The iterator functions give back a list of LightLine
+  instances built from the arrays. Changes of the lines through the
+  iterators are written back into the arrays by ::writeBack(), or by
+  the next change of the cage. The accessors of the arrays only read,
+  they can be called from several threads.
 */
 class LightCage 
 {
@@ -30,6 +41,8 @@ class LightCage
 // ----------------------------------------------
 
 public: 
+   //! Default constructor, an empty cage
+   LightCage(void);
 
    //! Compute the luminance, given the lookup-vector ray
    /*!
@@ -80,6 +93,10 @@ public:
    LightLine::Attenuation getAttenuation(void);
 
    //! Push a LightLine in the cage.
+   /*!
+     Radius and attenuation of the cage are used, the color of the
+     line is kept.
+   */
    void  pushback(LightLine);        // push of LightLine on LightCage
    //! Push a LightLine in the cage, given by float arrays
    void  pushback(float*, float *);  // push of LightLine on LightCage
@@ -104,9 +121,42 @@ public:
    LightLine& back(void);
 
    //! Get a iterator, pointing to the first lightline in the cage
+   /*!
+     The iterators run over a copy of the lines, built from the arrays
+     after each change of the cage. Changes using the iterators have
+     to be written back into the arrays with ::writeBack(), a change
+     of the cage itself, e.g. a translation, writes them back as well.
+     It builds a new copy, the iterators are invalid after that.
+   */
    list<LightLine>::iterator begin(void);
    //! Get a iterator, pointing to the last lightline in the cage
    list<LightLine>::iterator end(void);
+   //! Write the changes made through the iterators back into the arrays
+   /*!
+     The copy is compared with the arrays, O(n). Nothing is done, if no
+     iterators were given back since the copy was built. The revision
+     changes, if a line was changed.
+   */
+   void writeBack(void);
+
+   //! Query the points of the lines, 3 floats for every line
+   inline const float* getPoints(void) {return points.empty() ? 0 : &points[0];}
+   //! Query the directions of the lines, 3 floats for every line
+   inline const float* getDirections(void) {return directions.empty() ? 0 : &directions[0];}
+   //! Query the radius of the lines
+   inline const float* getRadii(void) {return radii.empty() ? 0 : &radii[0];}
+   //! Query the attenuation of line i
+   inline LightLine::Attenuation getAttenuation(int i) {return attenuations[i];}
+   //! Query the render length of line i
+   inline float getLength(int i) {return lengths[i];}
+   //! Is line i rendered as a cylinder?
+   inline bool getCylinder(int i) {return cylinders[i];}
+   //! Query the render color of line i as RGB float array
+   inline const float* getLineColor(int i) {return &colors[3*i];}
+   //! Query the render color of the cage as RGB float array
+   inline const float* getColor(void) {return color;}
+   //! Query the revision of the lines, it changes with every change of the cage
+   inline unsigned int getRevision(void) {return revision;}
  
    //! Translate all the cage lines
    virtual void translate(float, float, float)=0;
@@ -124,9 +174,9 @@ public:
    //! Render the cage as a OpenGL display list 
    void createList(GLuint);
 
-   //! Set the render color of the cage as RGB float array
+   //! Set the render color of the cage and of all lines as RGB float array
    void setColor(float color[3]);
-   //! Set the render color of the cage as RGB float array
+   //! Set the render color of the cage and of all lines as RGB float array
    void setColor(float, float, float);
 
    //! Set the radius for all lightlines and for the cage to new value
@@ -157,8 +207,67 @@ public:
 // protected
 // ----------------------------------------------
 protected:
-   //! Set of LightLines, using the STL list.
-   list<LightLine> cage;
+   //! Points of the lines, 3 floats for every line
+   vector<float> points;
+   //! Directions of the lines, 3 floats for every line
+   vector<float> directions;
+   //! Radius of the lines
+   vector<float> radii;
+   //! Attenuation of the lines
+   vector<LightLine::Attenuation> attenuations;
+   //! Render length of the lines
+   vector<float> lengths;
+   //! Render the line as a cylinder?
+   vector<bool> cylinders;
+   //! Render colors of the lines, 3 floats for every line
+   vector<float> colors;
+   //! Render color of the cage, used for new lines
+   float color[3];
+
+   //! Copy of the lines as LightLine, given back by ::begin() and ::end()
+   list<LightLine> view;
+   //! Counter for the changes of the lines
+   /*!
+     Every change of the lines increments the counter, derived data
+     like view store the value they are built for.
+   */
+   unsigned int revision;
+   //! Revision of the copy in view
+   unsigned int viewRevision;
+   //! Were iterators to the copy in view given back?
+   bool viewShared;
+
+   //! Mark the lines as changed
+   inline void modified(void) {revision++;}
+
+   //! Copy the lines and the homogenous attributes of a cage
+   void copyCage(const LightCage&);
+   //! Add a line, the direction is normalized
+   void addLine(const float p[3], const float d[3], float r,
+                LightLine::Attenuation a, float l, bool c, const float rgb[3]);
+   //! Rebuild view from the arrays
+   void updateView(void);
+   //! Luminance value for a distance pD to the line, relative to the radius
+   /*!
+     For |pD| > 1 the result is 0, inside the light form of the
+     attenuation a is used, like in LightLine::luminance().
+   */
+   static float attenuate(double pD, LightLine::Attenuation a);
+   //! Integral of the light form from 0 to t, t relative to the radius
+   /*!
+     The integral is odd in t and constant for |t| > 1.
+   */
+   static double integrate(double t, LightLine::Attenuation a);
+   //! Mean luminance over the distances [a, b], relative to the radius
+   /*!
+     This is the exact box filter of the light form over a texel covering
+     the distances a to b, computed with ::integrate().
+   */
+   static float boxFilter(double a, double b, LightLine::Attenuation form);
+   //! Translate the points of the lines
+   void translateLines(float x, float y, float z);
+   //! Rotate the directions of the lines around the axis (0=x, 1=y, 2=z)
+   void rotateLines(int axis, float degrees);
 
    // homogenous attributes. They are only stored here, so we don't have
    // to query these attributes every time looping over the cage ..
@@ -418,8 +418,12 @@ void LightLine::draw(void)
 	  GLUquadricObj *cyl = gluNewQuadric();
 	  gluQuadricNormals(cyl, GLU_SMOOTH);
 	  gluQuadricDrawStyle(cyl, GLU_FILL);
-	  // TODO: Rotation und Translation so, dass Zylinder passt!
-          gluCylinder(cyl, radius, radius, length, 20, 20);
+	  float p[3], d[3];
+	  getPoint(p);
+	  getDirection(d);
+	  glColor3fv(color);
+	  drawCylinder(cyl, p, d, radius, length);
+	  gluDeleteQuadric(cyl);
   }
   else {
 	  glColor3fv(color);
@@ -430,26 +434,42 @@ void LightLine::draw(void)
   }
 }
 
+// gluCylinder builds the cylinder along the z-axis, from z=0 to
+// z=length. The z-axis is rotated onto d around the axis e_3 x d.
+void LightLine::drawCylinder(GLUquadricObj *cyl, const float p[3], const float d[3],
+                             float radius, float length)
+{
+  float len, c, angle;
+
+  len = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+  if (len == 0.0f) return;
+  c = d[2]/len;
+  if (c > 1.0f) c = 1.0f;
+  if (c < -1.0f) c = -1.0f;
+  angle = static_cast<float>(acos(c)*180.0/M_PI);
+
+  glPushMatrix();
+  glTranslatef(p[0], p[1], p[2]);
+  // d parallel to the z-axis: any axis orthogonal to it
+  if ((d[0] == 0.0f) && (d[1] == 0.0f))
+     glRotatef(angle, 1.0f, 0.0f, 0.0f);
+  else
+     glRotatef(angle, -d[1], d[0], 0.0f);
+  gluCylinder(cyl, radius, radius, length, 20, 20);
+  glPopMatrix();
+}
+
 // 
 // Creating an OpenGL Display List
 //
 GLuint LightLine::createList(void)
 {
-  float p2[3];
   GLuint list = glGenLists(1);
-  
-  if (!cylinder) {
-  // compute second point
-  getPointOnLine(length, p2);
 
+  // lines and cylinders, placed on the line like in draw()
   glNewList(list, GL_COMPILE);
-       glColor3fv(color);
-       glBegin(GL_LINES);
-           glVertex3f(point.getX(), point.getY(), point.getZ());
-	   glVertex3fv(p2);
-       glEnd();       
+       draw();
   glEndList();
-  }
   return list;
 }
 
@@ -514,6 +534,20 @@ void LightLine::setDirection(float x, float y, float z)
   direction.set(x,y,z);
 }
 
+void LightLine::getPoint(float p[3])
+{
+  p[0] = point.getX();
+  p[1] = point.getY();
+  p[2] = point.getZ();
+}
+
+void LightLine::getDirection(float d[3])
+{
+  d[0] = direction.getX();
+  d[1] = direction.getY();
+  d[2] = direction.getZ();
+}
+
 float* LightLine::getDirection(void)
 {
   float* local = new float[3];
@@ -548,6 +582,13 @@ void LightLine::setColor(float c[3])
   color[2] = c[2];
 }
 
+void LightLine::getColor(float c[3])
+{
+  c[0] = color[0];
+  c[1] = color[1];
+  c[2] = color[2];
+}
+
 void LightLine::setCylinder(bool c)
 {
   cylinder = c;
@@ -225,9 +225,20 @@ public:
      Set the color as RGB float[3] used for rendering the line.
    */
    void setColor(float c[3]);
+   //! Query the render color as RGB float[3]
+   void getColor(float c[3]);
   
    //! Render the line in OpenGL
    void draw();
+   //! Render a cylinder around a line
+   /*!
+     The cylinder starts in the point p and has the axis d and the
+     given radius and length, like a light cylinder. gluCylinder()
+     builds it along the z-axis, it is rotated and translated onto
+     the line.
+   */
+   static void drawCylinder(GLUquadricObj*, const float p[3], const float d[3],
+                            float radius, float length);
 
    //! Get the line geometry as a OpenGL Display List
    /*!
@@ -256,12 +267,16 @@ public:
    void   setPoint(float, float, float);
    //! Get line point 
    float* getPoint(void);
+   //! Get line point 
+   void   getPoint(float p[3]);
    //! Set direction of line
    void   setDirection(float[]);
    //! Set direction of line
    void   setDirection(float, float, float);
    //! Get direction of line
    float* getDirection(void);
+   //! Get direction of line
+   void   getDirection(float d[3]);
    //! Set radius of the cylinder
    void   setRadius(float);
    //! Get radius of the cylinder
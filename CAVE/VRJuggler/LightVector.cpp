@@ -229,6 +229,21 @@ void LightVector::setRenderOrigin(Vector3 dir)
   renderOrigin = dir;
 }
 
+float* LightVector::getRenderOrigin(void)
+{
+  float* local = new float[3];
+
+  getRenderOrigin(local);
+  return local;
+}
+
+void LightVector::getRenderOrigin(float o[3])
+{
+  o[0] = renderOrigin.getX();
+  o[1] = renderOrigin.getY();
+  o[2] = renderOrigin.getZ();
+}
+
 void LightVector::setDirection(float dir[])
 {
   direction.set(dir[0], dir[1], dir[2]);;
@@ -249,6 +264,13 @@ float* LightVector::getDirection(void)
   return local;
 }
 
+void LightVector::getDirection(float d[3])
+{
+  d[0] = direction.getX();
+  d[1] = direction.getY();
+  d[2] = direction.getZ();
+}
+
 void LightVector::setColor(float r, float g, float b)
 {
   color[0] = r;
@@ -263,6 +285,13 @@ void LightVector::setColor(float c[3])
   color[2] = c[2];
 }
 
+void LightVector::getColor(float c[3])
+{
+  c[0] = color[0];
+  c[1] = color[1];
+  c[2] = color[2];
+}
+
 void LightVector::setLength(float s)
 {
   length = s;
@@ -138,6 +138,8 @@ public:
    void   setDirection(Vector3);
    //! Get direction of vector
    float* getDirection(void);
+   //! Get direction of vector
+   void   getDirection(float d[3]);
 
    //! Set the render origin used for display
    void setRenderOrigin(float origin[3]);
@@ -163,6 +165,8 @@ public:
      Set the color as RGB float[3] used for rendering the line.
    */
    void setColor(float c[3]);
+   //! Query the render color as RGB float[3]
+   void getColor(float c[3]);
 
 // ----------------------------------------
 //   private
@@ -0,0 +1,407 @@
+// --------------------------------------------------------------------
+//  LineChunks.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "LineChunks.h"
+
+#include <math.h>
+#include <algorithm>
+
+// Orders vertex indices by the coordinates of the vertices, equal
+// vertices get neighbours.
+struct VertexOrder
+{
+   const float *v;
+   VertexOrder(const float *vertices) : v(vertices) {}
+   bool operator()(int a, int b) const
+   {
+      if (v[3*a]   != v[3*b])   return v[3*a]   < v[3*b];
+      if (v[3*a+1] != v[3*b+1]) return v[3*a+1] < v[3*b+1];
+      if (v[3*a+2] != v[3*b+2]) return v[3*a+2] < v[3*b+2];
+      return a < b;
+   }
+};
+
+// Distance of the point p to the segment (a, b)
+static float segmentDistance(const float *p, const float *a, const float *b)
+{
+   float d[3], w[3], t, len = 0.0f, dot = 0.0f, dist = 0.0f;
+   int i;
+
+   for (i=0; i<3; i++) {
+       d[i] = b[i]-a[i];
+       w[i] = p[i]-a[i];
+       len += d[i]*d[i];
+       dot += d[i]*w[i];
+   }
+   t = (len > 0.0f) ? dot/len : 0.0f;
+   if (t < 0.0f) t = 0.0f;
+   if (t > 1.0f) t = 1.0f;
+   for (i=0; i<3; i++) dist += (w[i]-t*d[i])*(w[i]-t*d[i]);
+   return sqrt(dist);
+}
+
+LineChunks::LineChunks(void)
+{
+   resolution = 4;
+   numLevels = 4;
+   tolerance = 0.001f;
+   pixelError = 1.0f;
+   backFaceCulling = false;
+   drawnChunks = drawnSegments = 0;
+   backFacingChunks = backFacingSegments = 0;
+}
+
+void LineChunks::setResolution(int n)
+{
+   resolution = (n < 1) ? 1 : n;
+}
+
+int LineChunks::getResolution(void)
+{
+   return resolution;
+}
+
+void LineChunks::setLevels(int levels, float t)
+{
+   numLevels = (levels < 1) ? 1 : levels;
+   tolerance = t;
+}
+
+int LineChunks::getNumberOfLevels(void)
+{
+   return numLevels;
+}
+
+void LineChunks::setPixelError(float e)
+{
+   pixelError = e;
+}
+
+float LineChunks::getPixelError(void)
+{
+   return pixelError;
+}
+
+void LineChunks::setBackFaceCulling(bool b)
+{
+   backFaceCulling = b;
+}
+
+bool LineChunks::getBackFaceCulling(void)
+{
+   return backFaceCulling;
+}
+
+void LineChunks::build(MeshBuffer *buffer, const float *normals)
+{
+   const float *v = (const float*) buffer->getVertices();
+   int numSegments = buffer->getNumberOfVertices()/2;
+   float box[6], diagonal, size[3], m;
+   int i, j, k, s, c, l, cell[3], numCells;
+   vector<int> cellOf, order, segments, canonical;
+   vector< vector<int> > polylines;
+   vector<GLuint> indices;
+   vector<float> chunkNormals;
+
+   boxes.clear();
+   cones.clear();
+   first.clear();
+   count.clear();
+   levelError.clear();
+
+   if ((numSegments == 0) || (buffer->getAttributes() != 0)) {
+      buffer->setIndices(0, 0);
+      return;
+   }
+
+   // the bounding box of all segments
+   for (k=0; k<3; k++) box[2*k] = box[2*k+1] = v[k];
+   for (i=1; i<2*numSegments; i++)
+       for (k=0; k<3; k++) {
+           if (v[3*i+k] < box[2*k])   box[2*k]   = v[3*i+k];
+           if (v[3*i+k] > box[2*k+1]) box[2*k+1] = v[3*i+k];
+       }
+   diagonal = 0.0f;
+   for (k=0; k<3; k++) {
+       size[k] = box[2*k+1]-box[2*k];
+       diagonal += size[k]*size[k];
+   }
+   diagonal = sqrt(diagonal);
+
+   levelError.push_back(0.0f);
+   for (l=1; l<numLevels; l++)
+       levelError.push_back(tolerance*diagonal*pow(4.0f, (float) (l-1)));
+
+   // the cell of every segment, given by its midpoint
+   numCells = resolution*resolution*resolution;
+   cellOf.resize(numSegments);
+   for (s=0; s<numSegments; s++) {
+       for (k=0; k<3; k++) {
+           m = 0.5f*(v[6*s+k] + v[6*s+3+k]);
+           cell[k] = (size[k] > 0.0f) ? (int) (resolution*(m-box[2*k])/size[k]) : 0;
+           if (cell[k] >= resolution) cell[k] = resolution-1;
+       }
+       cellOf[s] = cell[0] + resolution*(cell[1] + resolution*cell[2]);
+   }
+   // segments sorted by cells, counting sort
+   vector<int> start(numCells+1, 0);
+   for (s=0; s<numSegments; s++) start[cellOf[s]+1]++;
+   for (c=0; c<numCells; c++) start[c+1] += start[c];
+   order.resize(numSegments);
+   vector<int> fill(start.begin(), start.end()-1);
+   for (s=0; s<numSegments; s++) order[fill[cellOf[s]]++] = s;
+
+   // equal vertices get the smallest index as canonical index
+   vector<int> sorted(2*numSegments);
+   for (i=0; i<2*numSegments; i++) sorted[i] = i;
+   sort(sorted.begin(), sorted.end(), VertexOrder(v));
+   canonical.resize(2*numSegments);
+   for (i=0; i<2*numSegments; i=j) {
+       for (j=i+1; j<2*numSegments; j++)
+           if ((v[3*sorted[j]]   != v[3*sorted[i]]) ||
+               (v[3*sorted[j]+1] != v[3*sorted[i]+1]) ||
+               (v[3*sorted[j]+2] != v[3*sorted[i]+2])) break;
+       for (k=i; k<j; k++) canonical[sorted[k]] = sorted[i];
+   }
+
+   for (c=0; c<numCells; c++) {
+       if (start[c] == start[c+1]) continue;
+       segments.assign(order.begin()+start[c], order.begin()+start[c+1]);
+
+       // the bounding box of the chunk
+       for (k=0; k<3; k++) box[2*k] = box[2*k+1] = v[6*segments[0]+k];
+       for (i=0; i<(int) segments.size(); i++)
+           for (j=0; j<2; j++)
+               for (k=0; k<3; k++) {
+                   m = v[6*segments[i]+3*j+k];
+                   if (m < box[2*k])   box[2*k]   = m;
+                   if (m > box[2*k+1]) box[2*k+1] = m;
+               }
+       boxes.insert(boxes.end(), box, box+6);
+
+       // the normal cone of the chunk, unbounded without normals
+       cones.push_back(NormalCone());
+       if (normals != 0) {
+          chunkNormals.clear();
+          for (i=0; i<(int) segments.size(); i++)
+              chunkNormals.insert(chunkNormals.end(), normals + 3*segments[i],
+                                  normals + 3*segments[i] + 3);
+          cones.back().build(chunkNormals);
+       }
+
+       // level 0: all segments of the chunk
+       first.push_back(indices.size());
+       for (i=0; i<(int) segments.size(); i++) {
+           indices.push_back(2*segments[i]);
+           indices.push_back(2*segments[i]+1);
+       }
+       count.push_back(indices.size() - first.back());
+
+       // the coarser levels: simplified polylines
+       chain(segments, canonical, polylines);
+       for (l=1; l<numLevels; l++) {
+           first.push_back(indices.size());
+           for (i=0; i<(int) polylines.size(); i++)
+               simplify(v, polylines[i], levelError[l], indices);
+           count.push_back(indices.size() - first.back());
+       }
+   }
+
+   buffer->setIndices(&indices[0], indices.size());
+}
+
+void LineChunks::draw(MeshBuffer *buffer, WideLines *wide)
+{
+   int c, i, l, chunks = getNumberOfChunks();
+
+   if (chunks == 0) return;
+
+   view.read();
+   drawFirst.clear();
+   drawCount.clear();
+   for (c=0; c<chunks; c++) {
+       l = chooseLevel(c);
+       if (l < 0) continue;
+       if (backFaceCulling && cones[c].isBackFacing(view, &boxes[6*c])) {
+          backFacingChunks++;
+          backFacingSegments += count[c*numLevels+l]/2;
+          continue;
+       }
+       drawFirst.push_back(first[c*numLevels+l]);
+       drawCount.push_back(count[c*numLevels+l]);
+       drawnChunks++;
+       drawnSegments += count[c*numLevels+l]/2;
+   }
+   if (drawFirst.empty()) return;
+
+   if (wide == 0) {
+      buffer->drawRanges(GL_LINES, &drawFirst[0], &drawCount[0], drawFirst.size());
+      return;
+   }
+   // the quads of the visible segments
+   const float *v = (const float*) buffer->getVertices();
+   wide->begin();
+   for (c=0; c<(int) drawFirst.size(); c++)
+       for (i=drawFirst[c]; i<drawFirst[c]+drawCount[c]; i+=2)
+           wide->addSegment(v + 3*buffer->getIndex(i), v + 3*buffer->getIndex(i+1));
+   wide->end();
+}
+
+int LineChunks::getNumberOfChunks(void)
+{
+   return boxes.size()/6;
+}
+
+int LineChunks::getNumberOfSegments(int level)
+{
+   int c, n = 0;
+
+   if ((level < 0) || (level >= numLevels)) return 0;
+   for (c=0; c<getNumberOfChunks(); c++) n += count[c*numLevels+level]/2;
+   return n;
+}
+
+unsigned int LineChunks::getDrawnChunks(void)
+{
+   return drawnChunks;
+}
+
+unsigned int LineChunks::getDrawnSegments(void)
+{
+   return drawnSegments;
+}
+
+unsigned int LineChunks::getBackFacingChunks(void)
+{
+   return backFacingChunks;
+}
+
+unsigned int LineChunks::getBackFacingSegments(void)
+{
+   return backFacingSegments;
+}
+
+void LineChunks::resetStatistics(void)
+{
+   drawnChunks = drawnSegments = 0;
+   backFacingChunks = backFacingSegments = 0;
+}
+
+//
+// private
+//
+int LineChunks::chooseLevel(int chunk)
+{
+   const float *box = &boxes[6*chunk];
+   float size;
+   int l;
+
+   if (view.isOutside(box)) return -1;
+
+   size = view.pixelSize(view.distance(box));
+   if (size <= 0.0f) return 0;
+   for (l=numLevels-1; l>0; l--)
+       if (levelError[l] <= pixelError*size) return l;
+   return 0;
+}
+
+// The segments are connected at vertices with the same canonical index.
+// Polylines start at end points and branchings, the remaining segments
+// belong to closed loops.
+void LineChunks::chain(const vector<int> &segments, const vector<int> &canonical,
+                       vector< vector<int> > &polylines)
+{
+   vector< pair<int,int> > ends;
+   vector< pair<int,int> >::iterator lo, hi, it;
+   vector<bool> visited(segments.size(), false);
+   int i, pass, a, b, vertex, next, s;
+
+   polylines.clear();
+
+   // the ends of the segments, sorted by the canonical vertex
+   for (i=0; i<(int) segments.size(); i++) {
+       a = canonical[2*segments[i]];
+       b = canonical[2*segments[i]+1];
+       // a segment of length 0 is only drawn at level 0
+       if (a == b) {
+          visited[i] = true;
+          continue;
+       }
+       ends.push_back(pair<int,int>(a, i));
+       ends.push_back(pair<int,int>(b, i));
+   }
+   sort(ends.begin(), ends.end());
+
+   for (pass=0; pass<2; pass++)
+   for (i=0; i<(int) ends.size(); i++) {
+       s = ends[i].second;
+       if (visited[s]) continue;
+       vertex = ends[i].first;
+       lo = lower_bound(ends.begin(), ends.end(), pair<int,int>(vertex, -1));
+       hi = upper_bound(ends.begin(), ends.end(), pair<int,int>(vertex, (int) segments.size()));
+       // first the open polylines
+       if ((pass == 0) && (hi-lo == 2)) continue;
+
+       polylines.push_back(vector<int>(1, vertex));
+       vector<int> &polyline = polylines.back();
+       while (true) {
+             visited[s] = true;
+             a = canonical[2*segments[s]];
+             next = (a == vertex) ? canonical[2*segments[s]+1] : a;
+             polyline.push_back(next);
+             vertex = next;
+
+             lo = lower_bound(ends.begin(), ends.end(), pair<int,int>(vertex, -1));
+             hi = upper_bound(ends.begin(), ends.end(), pair<int,int>(vertex, (int) segments.size()));
+             if (hi-lo != 2) break;
+             for (it=lo; it!=hi; ++it)
+                 if (!visited[it->second]) break;
+             if (it == hi) break;
+             s = it->second;
+       }
+   }
+}
+
+void LineChunks::simplify(const float *v, const vector<int> &polyline, float error,
+                          vector<GLuint> &indices)
+{
+   int n = polyline.size(), i, j, k, best, last;
+   float d, maxDist;
+   vector<bool> keep(n, false);
+   vector< pair<int,int> > stack;
+
+   keep[0] = keep[n-1] = true;
+   stack.push_back(pair<int,int>(0, n-1));
+   while (!stack.empty()) {
+         i = stack.back().first;
+         j = stack.back().second;
+         stack.pop_back();
+
+         best = -1;
+         maxDist = error;
+         for (k=i+1; k<j; k++) {
+             d = segmentDistance(v + 3*polyline[k], v + 3*polyline[i], v + 3*polyline[j]);
+             if (d > maxDist) {
+                maxDist = d;
+                best = k;
+             }
+         }
+         if (best < 0) continue;
+         keep[best] = true;
+         stack.push_back(pair<int,int>(i, best));
+         stack.push_back(pair<int,int>(best, j));
+   }
+
+   for (last=0, k=1; k<n; k++) {
+       if (!keep[k]) continue;
+       indices.push_back(polyline[last]);
+       indices.push_back(polyline[k]);
+       last = k;
+   }
+}
@@ -0,0 +1,154 @@
+// --------------------------------------------------------------------
+//  LineChunks.h
+//
+//  Line segments split into spatial chunks with bounding boxes and
+//  simplified levels, for view frustum culling and level of detail.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef LINECHUNKS
+#define LINECHUNKS
+
+#include <vector>
+#include <GL/gl.h>
+
+#include "MeshBuffer.h"
+#include "ViewFrustum.h"
+#include "NormalCone.h"
+#include "WideLines.h"
+
+using namespace std;
+
+//! Chunks of line segments with levels of detail
+/*!
+  The segments, two vertices each, are sorted into a uniform grid of
+  chunks over their bounding box, using the midpoint of a segment. Every
+  non-empty chunk has an axis aligned bounding box.
+
+  Level 0 of a chunk are all its segments. For the coarser levels the
+  segments of a chunk are chained into polylines, which are simplified
+  with the Douglas-Peucker algorithm. The tolerance of level 1 is given
+  relative to the diagonal of the bounding box, every further level has
+  four times the tolerance of the level before. The end points of the
+  polylines are kept, so there are no gaps at the chunk boundaries.
+  Chaining needs equal crossings on the common edge of two triangles,
+  which \link ContourEngine \endlink guarantees.
+
+  All levels only consist of indices into the vertices of the segments,
+  they are stored in the index buffer of the MeshBuffer holding the
+  vertices. No vertex is copied.
+
+  ::draw() takes the view from the current OpenGL matrices and the
+  viewport, see \link ViewFrustum \endlink. Chunks outside the view frustum are skipped, for the other
+  chunks the coarsest level is drawn whose tolerance projected at the
+  distance of the chunk is below the pixel error. Every channel, like a
+  wall of a CAVE, culls and chooses the levels for its own view. With
+  \link WideLines \endlink the visible segments are drawn as quads.
+
+  If the normals of the surface are given for the segments, every chunk
+  gets a \link NormalCone \endlink. With back face culling the chunks
+  on the back of the surface are not drawn, like the back faces of the
+  surface with GL_CULL_FACE.
+*/
+class LineChunks
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, 4 chunks along every axis and 4 levels
+   LineChunks(void);
+
+   //! Set the number of chunks along every axis
+   void  setResolution(int);
+   //! Query the number of chunks along every axis
+   int   getResolution(void);
+   //! Set the number of levels, including level 0, and the tolerance of level 1
+   void  setLevels(int levels, float tolerance);
+   //! Query the number of levels
+   int   getNumberOfLevels(void);
+   //! Set the error allowed on the screen in pixels, default 1
+   void  setPixelError(float);
+   //! Query the error allowed on the screen in pixels
+   float getPixelError(void);
+   //! Skip the back facing chunks, the default is false
+   void  setBackFaceCulling(bool);
+   //! Are the back facing chunks skipped?
+   bool  getBackFaceCulling(void);
+
+   //! Build the chunks and the levels
+   /*!
+     The segments are the vertices of the MeshBuffer, which has to
+     contain float positions only. The indices of the MeshBuffer
+     are replaced. The normals, 3 floats for every segment, are the
+     normals of the surface at the segments, their length does not
+     matter. Without normals there is no back face culling.
+   */
+   void build(MeshBuffer*, const float *normals = 0);
+   //! Draw the visible chunks of the MeshBuffer given to ::build()
+   /*!
+     The segments are drawn as GL_LINES, or with the WideLines in the
+     current color.
+   */
+   void draw(MeshBuffer*, WideLines *wide = 0);
+
+   //! Query the number of non-empty chunks
+   int  getNumberOfChunks(void);
+   //! Query the number of segments of a level in all chunks
+   int  getNumberOfSegments(int level);
+   //! Query the chunks drawn since the last ::resetStatistics()
+   unsigned int getDrawnChunks(void);
+   //! Query the segments drawn since the last ::resetStatistics()
+   unsigned int getDrawnSegments(void);
+   //! Query the chunks in the view skipped as back facing
+   unsigned int getBackFacingChunks(void);
+   //! Query the segments in the view skipped as back facing
+   unsigned int getBackFacingSegments(void);
+   //! Set the counters to 0
+   void resetStatistics(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! Number of chunks along every axis
+   int   resolution;
+   //! Number of levels
+   int   numLevels;
+   //! Tolerance of level 1 relative to the diagonal
+   float tolerance;
+   //! Error allowed on the screen in pixels
+   float pixelError;
+   //! Skip the back facing chunks?
+   bool  backFaceCulling;
+
+   //! Bounding boxes of the chunks, 6 floats each
+   vector<float> boxes;
+   //! Normal cones of the chunks
+   vector<NormalCone> cones;
+   //! First index and number of indices for every chunk and level
+   vector<int> first, count;
+   //! Absolute tolerance of every level
+   vector<float> levelError;
+
+   //! Counters
+   unsigned int drawnChunks, drawnSegments;
+   unsigned int backFacingChunks, backFacingSegments;
+
+   //! Ranges of the draw call, kept to avoid allocation
+   vector<int> drawFirst, drawCount;
+   //! The view of the last ::draw()
+   ViewFrustum view;
+
+   //! The coarsest level for a chunk, -1 if it is outside of the view
+   int  chooseLevel(int chunk);
+   //! Chain the segments into polylines of vertex indices
+   void chain(const vector<int> &segments, const vector<int> &canonical,
+              vector< vector<int> > &polylines);
+   //! Simplify a polyline and append its segments to the indices
+   void simplify(const float *v, const vector<int> &polyline, float error,
+                 vector<GLuint> &indices);
+};
+#endif
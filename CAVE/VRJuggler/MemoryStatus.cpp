@@ -0,0 +1,49 @@
+// --------------------------------------------------------------------
+//  MemoryStatus.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "MemoryStatus.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Read one entry of /proc/self/status, the values are given in kB
+static long readStatus(const char *key)
+{
+   char line[256];
+   long value = -1;
+   int  len = strlen(key);
+
+   FILE *status = fopen("/proc/self/status", "r");
+   if (status == NULL) return -1;
+
+   while (fgets(line, sizeof(line), status) != NULL)
+      if (strncmp(line, key, len) == 0) {
+         sscanf(line+len, "%ld", &value);
+         break;
+      }
+
+   fclose(status);
+   return value;
+}
+
+long getResidentMemory(void)
+{
+   return readStatus("VmRSS:");
+}
+
+long getPeakMemory(void)
+{
+   return readStatus("VmHWM:");
+}
+
+void printMemoryStatus(ostream &out, const char *label)
+{
+   out << label << ": " << getResidentMemory() << " kB resident, "
+       << getPeakMemory() << " kB peak" << endl;
+}
@@ -0,0 +1,34 @@
+// --------------------------------------------------------------------
+//  MemoryStatus.h
+//
+//  Query the memory used by the process, to compare the memory
+//  footprint of the VTK pipeline and the compact arrays.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef MEMORYSTATUS
+#define MEMORYSTATUS
+
+#include <iostream>
+
+using namespace std;
+
+//! Query the resident memory of the process in kilobytes
+/*!
+  The value is read from /proc/self/status (VmRSS). If the file does
+  not exist, -1 is given back.
+*/
+long getResidentMemory(void);
+
+//! Query the peak resident memory of the process in kilobytes
+/*!
+  The value is read from /proc/self/status (VmHWM). If the file does
+  not exist, -1 is given back.
+*/
+long getPeakMemory(void);
+
+//! Print the resident and the peak memory with a label
+void printMemoryStatus(ostream&, const char*);
+#endif
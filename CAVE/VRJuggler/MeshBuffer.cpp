@@ -0,0 +1,376 @@
+// --------------------------------------------------------------------
+//  MeshBuffer.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "MeshBuffer.h"
+#include "BufferObjects.h"
+
+#include <string.h>
+#include <iostream>
+
+MeshBuffer::MeshBuffer(int a)
+{
+   attributes = a;
+
+   // quantized: 4 shorts (one for the alignment) and 4 bytes,
+   // otherwise 3 floats for the position and the normal
+   if (attributes & Quantized) {
+      stride = 4*sizeof(short);
+      normalOffset = stride;
+      if (attributes & Normals) stride += 4;
+   }
+   else {
+      stride = 3*sizeof(float);
+      normalOffset = stride;
+      if (attributes & Normals) stride += 3*sizeof(float);
+   }
+   texCoordOffset = stride;
+   if (attributes & TexCoords) stride += 2*sizeof(float);
+
+   numVertices = 0;
+   dirtyFirst = dirtyEnd = 0;
+   indicesDirty = false;
+
+   initialized = false;
+   vertexBuffer = indexBuffer = 0;
+   vertexBufferSize = indexBufferSize = 0;
+
+   uploads = 0;
+   uploadedBytes = 0;
+}
+
+MeshBuffer::~MeshBuffer(void)
+{
+   if (vertexBuffer != 0) deleteBuffers(1, &vertexBuffer);
+   if (indexBuffer != 0)  deleteBuffers(1, &indexBuffer);
+}
+
+int MeshBuffer::getAttributes(void)
+{
+   return attributes;
+}
+
+int MeshBuffer::getStride(void)
+{
+   return stride;
+}
+
+void MeshBuffer::setNumberOfVertices(int n)
+{
+   if (n < 0) n = 0;
+   numVertices = n;
+   vertices.resize(n*stride);
+   // a dirty range of more vertices is cut
+   if (dirtyEnd > n) dirtyEnd = n;
+   markDirty(0, n);
+}
+
+int MeshBuffer::getNumberOfVertices(void)
+{
+   return numVertices;
+}
+
+void MeshBuffer::setPositions(int first, int n, const float *points)
+{
+   if ((attributes & Quantized) || !checkRange(first, n)) {
+      cerr << "MeshBuffer::setPositions: wrong format or range" << endl;
+      return;
+   }
+   for (int i=0; i<n; i++)
+       memcpy(vertex(first+i), points+3*i, 3*sizeof(float));
+   markDirty(first, n);
+}
+
+void MeshBuffer::setPositions(int first, int n, const short *points)
+{
+   short *p;
+
+   if (!(attributes & Quantized) || !checkRange(first, n)) {
+      cerr << "MeshBuffer::setPositions: wrong format or range" << endl;
+      return;
+   }
+   for (int i=0; i<n; i++) {
+       p = (short*) vertex(first+i);
+       p[0] = points[3*i]; p[1] = points[3*i+1]; p[2] = points[3*i+2];
+       p[3] = 1;
+   }
+   markDirty(first, n);
+}
+
+void MeshBuffer::setNormals(int first, int n, const float *normals)
+{
+   if ((attributes & Quantized) || !(attributes & Normals) || !checkRange(first, n)) {
+      cerr << "MeshBuffer::setNormals: wrong format or range" << endl;
+      return;
+   }
+   for (int i=0; i<n; i++)
+       memcpy(vertex(first+i) + normalOffset, normals+3*i, 3*sizeof(float));
+   markDirty(first, n);
+}
+
+void MeshBuffer::setNormals(int first, int n, const GLbyte *normals)
+{
+   if (!(attributes & Quantized) || !(attributes & Normals) || !checkRange(first, n)) {
+      cerr << "MeshBuffer::setNormals: wrong format or range" << endl;
+      return;
+   }
+   for (int i=0; i<n; i++)
+       memcpy(vertex(first+i) + normalOffset, normals+4*i, 4);
+   markDirty(first, n);
+}
+
+void MeshBuffer::setTexCoords(int first, int n, const float *tcoords)
+{
+   if (!(attributes & TexCoords) || !checkRange(first, n)) {
+      cerr << "MeshBuffer::setTexCoords: wrong format or range" << endl;
+      return;
+   }
+   for (int i=0; i<n; i++)
+       memcpy(vertex(first+i) + texCoordOffset, tcoords+2*i, 2*sizeof(float));
+   markDirty(first, n);
+}
+
+void MeshBuffer::markDirty(int first, int n)
+{
+   if (n <= 0) return;
+
+   if (dirtyFirst >= dirtyEnd) {
+      dirtyFirst = first;
+      dirtyEnd = first + n;
+      return;
+   }
+   if (first < dirtyFirst) dirtyFirst = first;
+   if (first + n > dirtyEnd) dirtyEnd = first + n;
+}
+
+void MeshBuffer::addVertex(const float *position)
+{
+   if (attributes != 0) {
+      cerr << "MeshBuffer::addVertex: wrong format" << endl;
+      return;
+   }
+   vertices.insert(vertices.end(), (const unsigned char*) position,
+                   (const unsigned char*) (position + 3));
+   numVertices++;
+   markDirty(numVertices-1, 1);
+}
+
+const unsigned char* MeshBuffer::getVertices(void)
+{
+   return vertices.empty() ? 0 : &vertices[0];
+}
+
+void MeshBuffer::setIndices(const GLuint *indices, int n)
+{
+   int i;
+
+   shortIndices.clear();
+   longIndices.clear();
+   if (numVertices <= 65536) {
+      shortIndices.resize(n);
+      for (i=0; i<n; i++) shortIndices[i] = (GLushort) indices[i];
+   }
+   else
+      longIndices.assign(indices, indices + n);
+   indicesDirty = true;
+}
+
+int MeshBuffer::getNumberOfIndices(void)
+{
+   return shortIndices.size() + longIndices.size();
+}
+
+bool MeshBuffer::hasShortIndices(void)
+{
+   return !shortIndices.empty();
+}
+
+void MeshBuffer::update(void)
+{
+   long size;
+   const void *data;
+
+   // the first call with a current context decides about buffer objects
+   if (!initialized && glGetString(GL_VERSION) != 0) {
+      initialized = true;
+      if (hasBufferObjects()) {
+         genBuffers(1, &vertexBuffer);
+         genBuffers(1, &indexBuffer);
+         markDirty(0, numVertices);
+         indicesDirty = true;
+      }
+   }
+   // client side arrays: nothing to upload
+   if (vertexBuffer == 0) {
+      if (initialized) {
+         dirtyFirst = dirtyEnd = 0;
+         indicesDirty = false;
+      }
+      return;
+   }
+
+   // the vertices: a new buffer only if the size has changed
+   if (dirtyFirst < dirtyEnd) {
+      bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+      size = (long) numVertices*stride;
+      if (size != vertexBufferSize) {
+         bufferData(GL_ARRAY_BUFFER, size, size ? &vertices[0] : 0, GL_DYNAMIC_DRAW);
+         vertexBufferSize = size;
+         uploadedBytes += size;
+      }
+      else {
+         bufferSubData(GL_ARRAY_BUFFER, (long) dirtyFirst*stride,
+                       (long) (dirtyEnd-dirtyFirst)*stride, vertex(dirtyFirst));
+         uploadedBytes += (long) (dirtyEnd-dirtyFirst)*stride;
+      }
+      bindBuffer(GL_ARRAY_BUFFER, 0);
+      dirtyFirst = dirtyEnd = 0;
+      uploads++;
+   }
+
+   if (indicesDirty) {
+      bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+      if (hasShortIndices()) {
+         size = shortIndices.size()*sizeof(GLushort);
+         data = &shortIndices[0];
+      }
+      else {
+         size = longIndices.size()*sizeof(GLuint);
+         data = longIndices.empty() ? 0 : &longIndices[0];
+      }
+      if (size != indexBufferSize) {
+         bufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+         indexBufferSize = size;
+      }
+      else if (size > 0)
+         bufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data);
+      bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+      indicesDirty = false;
+      uploadedBytes += size;
+      uploads++;
+   }
+}
+
+void MeshBuffer::draw(GLenum mode)
+{
+   int n = getNumberOfIndices();
+
+   update();
+   if (numVertices == 0) return;
+
+   enableArrays();
+   if (n == 0)
+      glDrawArrays(mode, 0, numVertices);
+   else
+      drawIndices(mode, 0, n);
+   disableArrays();
+}
+
+void MeshBuffer::drawRanges(GLenum mode, const int *first, const int *count, int n)
+{
+   int i;
+
+   update();
+   if ((numVertices == 0) || (getNumberOfIndices() == 0)) return;
+
+   enableArrays();
+   for (i=0; i<n; i++)
+       if (count[i] > 0) drawIndices(mode, first[i], count[i]);
+   disableArrays();
+}
+
+bool MeshBuffer::usesBufferObjects(void)
+{
+   return vertexBuffer != 0;
+}
+
+unsigned int MeshBuffer::getUploads(void)
+{
+   return uploads;
+}
+
+long MeshBuffer::getUploadedBytes(void)
+{
+   return uploadedBytes;
+}
+
+void MeshBuffer::resetStatistics(void)
+{
+   uploads = 0;
+   uploadedBytes = 0;
+}
+
+long MeshBuffer::getMemorySize(void)
+{
+   return vertices.capacity() + shortIndices.capacity()*sizeof(GLushort) +
+          longIndices.capacity()*sizeof(GLuint);
+}
+
+//
+// private
+//
+bool MeshBuffer::checkRange(int first, int n)
+{
+   return (first >= 0) && (n >= 0) && (first + n <= numVertices);
+}
+
+void MeshBuffer::enableArrays(void)
+{
+   const unsigned char *base;
+
+   glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+   if (vertexBuffer != 0) {
+      bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+      base = 0;
+   }
+   else
+      base = &vertices[0];
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   if (attributes & Quantized)
+      glVertexPointer(3, GL_SHORT, stride, base);
+   else
+      glVertexPointer(3, GL_FLOAT, stride, base);
+
+   if (attributes & Normals) {
+      glEnableClientState(GL_NORMAL_ARRAY);
+      glNormalPointer((attributes & Quantized) ? GL_BYTE : GL_FLOAT, stride,
+                      base + normalOffset);
+   }
+   else
+      glDisableClientState(GL_NORMAL_ARRAY);
+
+   if (attributes & TexCoords) {
+      glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+      glTexCoordPointer(2, GL_FLOAT, stride, base + texCoordOffset);
+   }
+   if (indexBuffer != 0) bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+}
+
+void MeshBuffer::disableArrays(void)
+{
+   if (indexBuffer != 0)  bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+   if (vertexBuffer != 0) bindBuffer(GL_ARRAY_BUFFER, 0);
+   glPopClientAttrib();
+}
+
+// With an index buffer the pointer is an offset into the buffer
+void MeshBuffer::drawIndices(GLenum mode, int first, int count)
+{
+   const unsigned char *indices;
+
+   if (hasShortIndices())
+      indices = (indexBuffer != 0) ? 0 : (const unsigned char*) &shortIndices[0];
+   else
+      indices = (indexBuffer != 0) ? 0 : (const unsigned char*) &longIndices[0];
+
+   if (hasShortIndices())
+      glDrawElements(mode, count, GL_UNSIGNED_SHORT, indices + first*sizeof(GLushort));
+   else
+      glDrawElements(mode, count, GL_UNSIGNED_INT, indices + first*sizeof(GLuint));
+}
@@ -0,0 +1,177 @@
+// --------------------------------------------------------------------
+//  MeshBuffer.h
+//
+//  A mesh in vertex and index buffer objects, uploaded once and
+//  updated in dirty ranges.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef MESHBUFFER
+#define MESHBUFFER
+
+#include <vector>
+#include <GL/gl.h>
+
+using namespace std;
+
+//! A mesh stored in buffer objects
+/*!
+  The vertices are interleaved: the position, optionally the normal
+  and the texture coordinates. With the attribute Quantized the
+  positions are 16 bit integers and the normals are bytes, like the
+  compressed arrays of \link InterrogationObject \endlink, the
+  dequantization is left to the modelview matrix. Without it positions
+  and normals are floats.
+
+  The indices are stored with 16 bit if all vertices can be addressed,
+  otherwise with 32 bit. Without indices the vertices are drawn in
+  their order, for example line segments.
+
+  A client copy of the vertices is the source of the uploads. The set
+  functions write into the copy and mark the vertices as dirty, all
+  dirty vertices are merged into one range. ::draw() uploads the dirty
+  range with glBufferSubData() and the indices if they have changed,
+  the buffers are only allocated again if the number of vertices or
+  indices has changed. A frame without changes costs a bind and one
+  draw call, independent of the size of the mesh.
+
+  Without buffer objects, see hasBufferObjects(), the client copy is
+  drawn as vertex array.
+*/
+class MeshBuffer
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! The attributes of a vertex besides the position
+   enum Attribute {Normals = 1, TexCoords = 2, Quantized = 4};
+
+   //! Constructor, the int is a combination of the attributes
+   MeshBuffer(int attributes = Normals);
+   //! Destructor, the buffer objects are deleted
+   ~MeshBuffer(void);
+
+   //! Query the attributes
+   int  getAttributes(void);
+   //! Query the size of a vertex in bytes
+   int  getStride(void);
+
+   //! Set the number of vertices, all vertices are dirty
+   void setNumberOfVertices(int);
+   //! Query the number of vertices
+   int  getNumberOfVertices(void);
+
+   //! Set the float positions of n vertices, starting at first
+   void setPositions(int first, int n, const float *points);
+   //! Set the quantized positions of n vertices, starting at first
+   void setPositions(int first, int n, const short *points);
+   //! Set the float normals of n vertices, starting at first
+   void setNormals(int first, int n, const float *normals);
+   //! Set the byte normals of n vertices, starting at first, 4 bytes for every normal
+   void setNormals(int first, int n, const GLbyte *normals);
+   //! Set the texture coordinates of n vertices, starting at first
+   void setTexCoords(int first, int n, const float *tcoords);
+   //! Mark n vertices as dirty, starting at first
+   void markDirty(int first, int n);
+   //! Append a vertex with a float position and no other attributes
+   /*!
+     The client copy keeps its capacity if the number of vertices is
+     set to 0, so a producer like \link ContourEngine \endlink can write
+     its output directly into the copy, without an own array.
+   */
+   void addVertex(const float *position);
+   //! The client copy of the vertices, interleaved with the stride
+   const unsigned char* getVertices(void);
+
+   //! Set the indices, 16 bit if every vertex can be addressed
+   /*!
+     The number of vertices has to be set first.
+   */
+   void setIndices(const GLuint *indices, int n);
+   //! Query the number of indices
+   int  getNumberOfIndices(void);
+   //! Are the indices stored with 16 bit?
+   bool hasShortIndices(void);
+   //! Query index i of the client copy
+   inline GLuint getIndex(int i)
+      {return shortIndices.empty() ? longIndices[i] : shortIndices[i];}
+
+   //! Upload the dirty vertices and the changed indices
+   /*!
+     A valid GL context is needed. ::draw() calls this function.
+   */
+   void update(void);
+   //! Render the mesh with the primitive mode, e.g. GL_TRIANGLES or GL_LINES
+   /*!
+     The client state of the vertex arrays is saved and restored.
+   */
+   void draw(GLenum mode);
+   //! Render n ranges of indices, given by the first index and the number of indices
+   /*!
+     The vertex arrays are set up once for all ranges.
+   */
+   void drawRanges(GLenum mode, const int *first, const int *count, int n);
+
+   //! Are buffer objects used?
+   bool usesBufferObjects(void);
+   //! Query the number of uploads since the last ::resetStatistics()
+   unsigned int getUploads(void);
+   //! Query the bytes uploaded since the last ::resetStatistics()
+   long getUploadedBytes(void);
+   //! Set the counters to 0
+   void resetStatistics(void);
+   //! Query the memory used by the client copy in bytes
+   long getMemorySize(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The attributes
+   int attributes;
+   //! Size of a vertex and offsets of the normal and texture coordinates in bytes
+   int stride, normalOffset, texCoordOffset;
+   //! Number of vertices
+   int numVertices;
+   //! Client copy of the interleaved vertices
+   vector<unsigned char> vertices;
+   //! Indices with 16 bit
+   vector<GLushort> shortIndices;
+   //! Indices with 32 bit
+   vector<GLuint> longIndices;
+
+   //! Dirty vertices [dirtyFirst, dirtyEnd), empty if dirtyFirst >= dirtyEnd
+   int dirtyFirst, dirtyEnd;
+   //! Have the indices changed?
+   bool indicesDirty;
+
+   //! Has the GL been queried for buffer objects?
+   bool initialized;
+   //! Buffer objects, 0 for client side arrays
+   GLuint vertexBuffer, indexBuffer;
+   //! Size of the buffer objects in bytes
+   long vertexBufferSize, indexBufferSize;
+
+   //! Counters
+   unsigned int uploads;
+   long uploadedBytes;
+
+   // the buffer objects are not shared
+   MeshBuffer(const MeshBuffer&);
+   MeshBuffer& operator=(const MeshBuffer&);
+
+   //! Address of vertex i in the client copy
+   inline unsigned char* vertex(int i) {return &vertices[0] + i*stride;}
+   //! Check the range of vertices for a set function
+   bool checkRange(int first, int n);
+   //! Bind the buffers and set the vertex arrays
+   void enableArrays(void);
+   //! Unbind the buffers, the client state is restored
+   void disableArrays(void);
+   //! Render count indices, starting with index first
+   void drawIndices(GLenum mode, int first, int count);
+};
+#endif
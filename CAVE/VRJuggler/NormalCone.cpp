@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------
+//  NormalCone.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "NormalCone.h"
+
+#include <math.h>
+
+NormalCone::NormalCone(void)
+{
+   axis[0] = axis[1] = 0.0f;
+   axis[2] = 1.0f;
+   cosAngle = 0.0f;
+   sinAngle = 1.0f;
+   bounded = false;
+}
+
+// Normals of length 0, e.g. of degenerated triangles, are ignored
+void NormalCone::build(const float *normals, int n)
+{
+   float len, d, minCos = 1.0f;
+   double sum[3] = {0.0, 0.0, 0.0};
+   int i, k;
+
+   bounded = false;
+   cosAngle = 0.0f;
+   sinAngle = 1.0f;
+
+   for (i=0; i<n; i++) {
+       const float *m = normals + 3*i;
+       len = sqrt(m[0]*m[0] + m[1]*m[1] + m[2]*m[2]);
+       if (len == 0.0f) continue;
+       for (k=0; k<3; k++) sum[k] += m[k]/len;
+   }
+   len = sqrt(sum[0]*sum[0] + sum[1]*sum[1] + sum[2]*sum[2]);
+   if (len == 0.0f) return;
+   for (k=0; k<3; k++) axis[k] = (float) (sum[k]/len);
+
+   for (i=0; i<n; i++) {
+       const float *m = normals + 3*i;
+       len = sqrt(m[0]*m[0] + m[1]*m[1] + m[2]*m[2]);
+       if (len == 0.0f) continue;
+       d = (axis[0]*m[0] + axis[1]*m[1] + axis[2]*m[2])/len;
+       if (d < minCos) minCos = d;
+   }
+   if (minCos <= 0.0f) return;
+
+   cosAngle = minCos;
+   sinAngle = sqrt(1.0f - minCos*minCos);
+   bounded = true;
+}
+
+void NormalCone::build(const vector<float> &normals)
+{
+   if (normals.empty())
+      build(0, 0);
+   else
+      build(&normals[0], normals.size()/3);
+}
+
+bool NormalCone::isBounded(void) const
+{
+   return bounded;
+}
+
+// Back facing, if the angle between the axis and the direction to the
+// viewer is more than 90 degrees plus the opening angle plus the angle
+// of the bounding sphere seen from the eye. For a parallel projection
+// the direction is the same for every point.
+bool NormalCone::isBackFacing(const ViewFrustum &view, const float box[6]) const
+{
+   float center[3], v[3], r = 0.0f, dist, sinB, cosB, k;
+   int i;
+
+   if (!bounded) return false;
+
+   for (i=0; i<3; i++) {
+       center[i] = 0.5f*(box[2*i] + box[2*i+1]);
+       r += 0.25f*(box[2*i+1]-box[2*i])*(box[2*i+1]-box[2*i]);
+   }
+   r = sqrt(r);
+
+   view.toViewer(center, v);
+   dist = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+   if (dist == 0.0f) return false;
+   if (view.isPerspective()) {
+      if (dist <= r) return false;
+      sinB = r/dist;
+      cosB = sqrt(1.0f - sinB*sinB);
+   }
+   else {
+      sinB = 0.0f;
+      cosB = 1.0f;
+   }
+
+   // cos(90 + a + b) = -sin(a + b), no culling if a + b >= 90 degrees
+   if (cosAngle*cosB - sinAngle*sinB <= 0.0f) return false;
+   k = (axis[0]*v[0] + axis[1]*v[1] + axis[2]*v[2])/dist;
+   return k < -(sinAngle*cosB + cosAngle*sinB);
+}
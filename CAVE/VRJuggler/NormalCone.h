@@ -0,0 +1,63 @@
+// --------------------------------------------------------------------
+//  NormalCone.h
+//
+//  A cone containing the normals of a part of a surface, for the
+//  culling of back facing parts.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef NORMALCONE
+#define NORMALCONE
+
+#include <vector>
+
+#include "ViewFrustum.h"
+
+using namespace std;
+
+//! A cone containing a set of normals
+/*!
+  The axis is the normalized mean of the normals, the opening angle is
+  the largest angle between the axis and a normal. A part of a surface
+  with the normals in the cone and the points in a box is back facing,
+  if the direction to the viewer makes an angle of more than 90 degrees
+  with every normal, for every point of the box. ::isBackFacing() tests
+  this conservatively with the bounding sphere of the box (Shirman,
+  Abi-Ezzi).
+
+  A cone with an opening angle of 90 degrees or more is never back
+  facing, like the default cone.
+*/
+class NormalCone
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, a cone that is never back facing
+   NormalCone(void);
+
+   //! Build the cone for n normals, 3 floats each, the length does not matter
+   void build(const float *normals, int n);
+   //! Build the cone for the normals, 3 floats each
+   void build(const vector<float> &normals);
+
+   //! Can the cone be back facing at all?
+   bool isBounded(void) const;
+   //! Is every point of the box back facing for the view?
+   bool isBackFacing(const ViewFrustum&, const float box[6]) const;
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The axis, normalized
+   float axis[3];
+   //! Cosine and sine of the opening angle
+   float cosAngle, sinAngle;
+   //! Is the opening angle less than 90 degrees?
+   bool  bounded;
+};
+#endif
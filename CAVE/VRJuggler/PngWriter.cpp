@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------
+//  PngWriter.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "PngWriter.h"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace std;
+
+static unsigned long crcTable[256];
+static bool crcTableComputed = false;
+
+static void makeCrcTable(void)
+{
+   unsigned long c;
+   int n, k;
+
+   for (n=0; n<256; n++) {
+       c = (unsigned long) n;
+       for (k=0; k<8; k++)
+           c = (c & 1) ? 0xedb88320UL ^ (c >> 1) : c >> 1;
+       crcTable[n] = c;
+   }
+   crcTableComputed = true;
+}
+
+static unsigned long updateCrc(unsigned long crc, const unsigned char *buf, int len)
+{
+   if (!crcTableComputed) makeCrcTable();
+
+   for (int i=0; i<len; i++)
+       crc = crcTable[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+   return crc;
+}
+
+static void putLong(vector<unsigned char> &out, unsigned long v)
+{
+   out.push_back((v >> 24) & 0xff);
+   out.push_back((v >> 16) & 0xff);
+   out.push_back((v >> 8) & 0xff);
+   out.push_back(v & 0xff);
+}
+
+// length, type, data and the CRC of type and data
+static bool writeChunk(FILE *file, const char *type,
+                       const vector<unsigned char> &data)
+{
+   vector<unsigned char> head;
+   unsigned long crc;
+   unsigned char tail[4];
+
+   putLong(head, data.size());
+   head.insert(head.end(), type, type+4);
+   crc = updateCrc(0xffffffffUL, &head[4], 4);
+   if (!data.empty()) crc = updateCrc(crc, &data[0], data.size());
+   crc ^= 0xffffffffUL;
+   tail[0] = (crc >> 24) & 0xff; tail[1] = (crc >> 16) & 0xff;
+   tail[2] = (crc >> 8) & 0xff;  tail[3] = crc & 0xff;
+
+   if (fwrite(&head[0], 1, 8, file) != 8) return false;
+   if (!data.empty() && fwrite(&data[0], 1, data.size(), file) != data.size())
+      return false;
+   return fwrite(tail, 1, 4, file) == 4;
+}
+
+bool writePNG(const char *filename, int width, int height,
+              const unsigned char *rgba)
+{
+   static const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+   vector<unsigned char> header, raw, data;
+   unsigned long a = 1, b = 0;
+   const unsigned char *row;
+   unsigned int i, block, length;
+   int x, y;
+   FILE *file;
+   bool ok;
+
+   // filter type 0 and RGB for every row, top row first
+   raw.reserve(height*(3*width+1));
+   for (y=height-1; y>=0; y--) {
+       raw.push_back(0);
+       row = rgba + 4*width*y;
+       for (x=0; x<width; x++) {
+           raw.push_back(row[4*x]);
+           raw.push_back(row[4*x+1]);
+           raw.push_back(row[4*x+2]);
+       }
+   }
+
+   // zlib stream with stored blocks, at most 65535 bytes each
+   data.push_back(0x78); data.push_back(0x01);
+   for (i=0; i<raw.size() || i==0; i+=block) {
+       block = raw.size() - i;
+       if (block > 65535) block = 65535;
+       data.push_back((i+block == raw.size()) ? 1 : 0);
+       data.push_back(block & 0xff); data.push_back(block >> 8);
+       data.push_back(~block & 0xff); data.push_back((~block >> 8) & 0xff);
+       data.insert(data.end(), raw.begin()+i, raw.begin()+i+block);
+       if (block == 0) break;
+   }
+   for (i=0; i<raw.size(); i++) {
+       a = (a + raw[i]) % 65521;
+       b = (b + a) % 65521;
+   }
+   putLong(data, (b << 16) | a);
+
+   putLong(header, width);
+   putLong(header, height);
+   header.push_back(8);   // bit depth
+   header.push_back(2);   // RGB
+   header.push_back(0);   // deflate
+   header.push_back(0);   // adaptive filtering
+   header.push_back(0);   // no interlace
+
+   file = fopen(filename, "wb");
+   if (file == NULL) return false;
+
+   length = sizeof(signature);
+   ok = (fwrite(signature, 1, length, file) == length) &&
+        writeChunk(file, "IHDR", header) &&
+        writeChunk(file, "IDAT", data) &&
+        writeChunk(file, "IEND", vector<unsigned char>());
+   if (fclose(file) != 0) ok = false;
+
+   return ok;
+}
@@ -0,0 +1,25 @@
+// --------------------------------------------------------------------
+//  PngWriter.h
+//
+//  Write a frame as a PNG file, to compare rendered images.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef PNGWRITER
+#define PNGWRITER
+
+//! Write an RGBA image as an RGB PNG file
+/*!
+  The image has width*height pixels with 4 bytes, the first row is the
+  bottom row like in glReadPixels(). The alpha channel is dropped.
+
+  The image data is written in stored deflate blocks, without
+  compression and without libpng or zlib. The files are larger, but
+  every PNG reader can open them and identical frames give identical
+  files. The result is false, if the file can not be written.
+*/
+bool writePNG(const char *filename, int width, int height,
+              const unsigned char *rgba);
+#endif
@@ -0,0 +1,377 @@
+// --------------------------------------------------------------------
+//  ScalarKernels.cpp
+//
+//  Implementation. If the compiler supports SSE2 (__SSE2__), four
+//  vertices are processed at once, the decoding of the compressed
+//  attributes is done in the SSE registers.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "ScalarKernels.h"
+
+#include <math.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//
+// Quantization and octahedral encoding
+//
+void computeQuantization(const float box[6], Quantization &q)
+{
+   for (int i=0; i<3; i++) {
+       float extent = box[2*i+1]-box[2*i];
+       q.scale[i]  = (extent > 0.0f) ? extent/65535.0f : 1.0f/65535.0f;
+       q.offset[i] = box[2*i] + 32768.0f*q.scale[i];
+   }
+}
+
+void quantizePoint(const float p[3], const Quantization &q, short out[3])
+{
+   for (int i=0; i<3; i++) {
+       float v = floor((p[i]-q.offset[i])/q.scale[i] + 0.5f);
+       if (v < -32768.0f) v = -32768.0f;
+       if (v >  32767.0f) v =  32767.0f;
+       out[i] = static_cast<short>(v);
+   }
+}
+
+void dequantizePoint(const short in[3], const Quantization &q, float p[3])
+{
+   for (int i=0; i<3; i++)
+       p[i] = q.offset[i] + q.scale[i]*in[i];
+}
+
+static inline float signOf(float v)
+{
+   return (v >= 0.0f) ? 1.0f : -1.0f;
+}
+
+static inline short toSnorm16(float v)
+{
+   if (v < -1.0f) v = -1.0f;
+   if (v >  1.0f) v =  1.0f;
+   return static_cast<short>(floor(v*32767.0f + 0.5f));
+}
+
+unsigned int encodeOctahedral(const float n[3])
+{
+   float s = fabs(n[0]) + fabs(n[1]) + fabs(n[2]);
+   float x = (s > 0.0f) ? n[0]/s : 0.0f,
+         y = (s > 0.0f) ? n[1]/s : 0.0f;
+
+   // fold the lower half over the upper half
+   if (n[2] < 0.0f) {
+      float fx = (1.0f - fabs(y))*signOf(x),
+            fy = (1.0f - fabs(x))*signOf(y);
+      x = fx; y = fy;
+   }
+
+   return static_cast<unsigned short>(toSnorm16(x)) |
+          (static_cast<unsigned int>(static_cast<unsigned short>(toSnorm16(y))) << 16);
+}
+
+void decodeOctahedral(unsigned int code, float n[3])
+{
+   float x = static_cast<short>(code & 0xffff)/32767.0f,
+         y = static_cast<short>(code >> 16)/32767.0f,
+         z = 1.0f - fabs(x) - fabs(y),
+         t = (z < 0.0f) ? -z : 0.0f, len;
+
+   x -= t*signOf(x);
+   y -= t*signOf(y);
+   len = 1.0f/sqrt(x*x + y*y + z*z);
+   n[0] = x*len; n[1] = y*len; n[2] = z*len;
+}
+
+//
+// The scalar functions for one vertex
+//
+static inline float distance(const float c[3], const float linePoint[3],
+                             const float s[3])
+{
+   return c[0]*(linePoint[0]-s[0]) + c[1]*(linePoint[1]-s[1]) +
+          c[2]*(linePoint[2]-s[2]);
+}
+
+static inline void cross(const float a[3], const float b[3], float c[3])
+{
+   c[0] = a[1]*b[2] - a[2]*b[1];
+   c[1] = a[2]*b[0] - a[0]*b[2];
+   c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static inline float highlightValue(const float s[3], const float n[3],
+                                   const float linePoint[3],
+                                   const float lineDirection[3])
+{
+   float c[3];
+   cross(lineDirection, n, c);
+   return distance(c, linePoint, s);
+}
+
+static inline float reflectionValue(const float s[3], const float n[3],
+                                    const float linePoint[3],
+                                    const float lineDirection[3],
+                                    const float eye[3])
+{
+   float v[3], r[3], c[3], len, nv;
+
+   v[0] = eye[0]-s[0]; v[1] = eye[1]-s[1]; v[2] = eye[2]-s[2];
+   len = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+   if (len > 0.0f) {
+      v[0] /= len; v[1] /= len; v[2] /= len;
+   }
+   nv = 2.0f*(n[0]*v[0] + n[1]*v[1] + n[2]*v[2]);
+   r[0] = nv*n[0]-v[0]; r[1] = nv*n[1]-v[1]; r[2] = nv*n[2]-v[2];
+
+   cross(lineDirection, r, c);
+   return distance(c, linePoint, s);
+}
+
+static inline void normalized(const float *in, float n[3])
+{
+   float len = sqrt(in[0]*in[0] + in[1]*in[1] + in[2]*in[2]);
+   if (len == 0.0f) len = 1.0f;
+   n[0] = in[0]/len; n[1] = in[1]/len; n[2] = in[2]/len;
+}
+
+#ifdef __SSE2__
+//
+// SSE2 helpers, 4 vertices in structure of arrays layout
+//
+static inline void load4(const float *a, __m128 &x, __m128 &y, __m128 &z)
+{
+   x = _mm_setr_ps(a[0], a[3], a[6], a[9]);
+   y = _mm_setr_ps(a[1], a[4], a[7], a[10]);
+   z = _mm_setr_ps(a[2], a[5], a[8], a[11]);
+}
+
+static inline void load4(const short *a, const Quantization &q,
+                         __m128 &x, __m128 &y, __m128 &z)
+{
+   x = _mm_setr_ps(a[0], a[3], a[6], a[9]);
+   y = _mm_setr_ps(a[1], a[4], a[7], a[10]);
+   z = _mm_setr_ps(a[2], a[5], a[8], a[11]);
+   x = _mm_add_ps(_mm_set1_ps(q.offset[0]), _mm_mul_ps(_mm_set1_ps(q.scale[0]), x));
+   y = _mm_add_ps(_mm_set1_ps(q.offset[1]), _mm_mul_ps(_mm_set1_ps(q.scale[1]), y));
+   z = _mm_add_ps(_mm_set1_ps(q.offset[2]), _mm_mul_ps(_mm_set1_ps(q.scale[2]), z));
+}
+
+// 1/sqrt with one Newton step, about 22 bits
+static inline __m128 invSqrt(__m128 v)
+{
+   __m128 r = _mm_rsqrt_ps(v);
+   return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f),
+                        _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), v),
+                                   _mm_mul_ps(r, r))));
+}
+
+static inline void normalize4(__m128 &x, __m128 &y, __m128 &z)
+{
+   __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                            _mm_mul_ps(z, z));
+   // avoid the division by zero for degenerated normals
+   __m128 r = invSqrt(_mm_max_ps(len2, _mm_set1_ps(1.0e-20f)));
+   x = _mm_mul_ps(x, r); y = _mm_mul_ps(y, r); z = _mm_mul_ps(z, r);
+}
+
+static inline void decode4(const unsigned int *code, __m128 &x, __m128 &y, __m128 &z)
+{
+   const __m128 signMask = _mm_set1_ps(-0.0f), zero = _mm_setzero_ps();
+   __m128i c  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(code));
+   __m128i ix = _mm_srai_epi32(_mm_slli_epi32(c, 16), 16);
+   __m128i iy = _mm_srai_epi32(c, 16);
+   __m128 norm = _mm_set1_ps(1.0f/32767.0f), t;
+
+   x = _mm_mul_ps(_mm_cvtepi32_ps(ix), norm);
+   y = _mm_mul_ps(_mm_cvtepi32_ps(iy), norm);
+   z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(signMask, x)),
+                  _mm_andnot_ps(signMask, y));
+   // unfold the lower half: x -= sign(x)*max(-z, 0)
+   t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+   x = _mm_sub_ps(x, _mm_or_ps(t, _mm_and_ps(signMask, x)));
+   y = _mm_sub_ps(y, _mm_or_ps(t, _mm_and_ps(signMask, y)));
+   normalize4(x, y, z);
+}
+
+static inline __m128 distance4(__m128 cx, __m128 cy, __m128 cz,
+                               __m128 sx, __m128 sy, __m128 sz,
+                               const float linePoint[3])
+{
+   __m128 dx = _mm_sub_ps(_mm_set1_ps(linePoint[0]), sx),
+          dy = _mm_sub_ps(_mm_set1_ps(linePoint[1]), sy),
+          dz = _mm_sub_ps(_mm_set1_ps(linePoint[2]), sz);
+   return _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, dx), _mm_mul_ps(cy, dy)),
+                     _mm_mul_ps(cz, dz));
+}
+
+static inline __m128 highlight4(__m128 sx, __m128 sy, __m128 sz,
+                                __m128 nx, __m128 ny, __m128 nz,
+                                const float linePoint[3], const float d[3])
+{
+   __m128 dx = _mm_set1_ps(d[0]), dy = _mm_set1_ps(d[1]), dz = _mm_set1_ps(d[2]);
+   __m128 cx = _mm_sub_ps(_mm_mul_ps(dy, nz), _mm_mul_ps(dz, ny)),
+          cy = _mm_sub_ps(_mm_mul_ps(dz, nx), _mm_mul_ps(dx, nz)),
+          cz = _mm_sub_ps(_mm_mul_ps(dx, ny), _mm_mul_ps(dy, nx));
+   return distance4(cx, cy, cz, sx, sy, sz, linePoint);
+}
+
+static inline __m128 reflection4(__m128 sx, __m128 sy, __m128 sz,
+                                 __m128 nx, __m128 ny, __m128 nz,
+                                 const float linePoint[3], const float d[3],
+                                 const float eye[3])
+{
+   __m128 vx = _mm_sub_ps(_mm_set1_ps(eye[0]), sx),
+          vy = _mm_sub_ps(_mm_set1_ps(eye[1]), sy),
+          vz = _mm_sub_ps(_mm_set1_ps(eye[2]), sz), nv;
+
+   normalize4(vx, vy, vz);
+   nv = _mm_mul_ps(_mm_set1_ps(2.0f),
+                   _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, vx), _mm_mul_ps(ny, vy)),
+                              _mm_mul_ps(nz, vz)));
+   return highlight4(sx, sy, sz,
+                     _mm_sub_ps(_mm_mul_ps(nv, nx), vx),
+                     _mm_sub_ps(_mm_mul_ps(nv, ny), vy),
+                     _mm_sub_ps(_mm_mul_ps(nv, nz), vz), linePoint, d);
+}
+
+static inline __m128 dot4(__m128 x, __m128 y, __m128 z, const float d[3])
+{
+   return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(d[0])),
+                                _mm_mul_ps(y, _mm_set1_ps(d[1]))),
+                     _mm_mul_ps(z, _mm_set1_ps(d[2])));
+}
+#endif
+
+//
+// The batch kernels. The SSE2 loop handles blocks of 4 vertices, the
+// rest is done by the scalar loop.
+//
+void isophoteValues(const float *normals, int n,
+                    const float direction[3], float *values)
+{
+   int i = 0;
+#ifdef __SSE2__
+   __m128 x, y, z;
+   for (; i+4<=n; i+=4) {
+       load4(normals+3*i, x, y, z);
+       _mm_storeu_ps(values+i, dot4(x, y, z, direction));
+   }
+#endif
+   for (; i<n; i++) {
+       const float *m = normals+3*i;
+       values[i] = m[0]*direction[0] + m[1]*direction[1] + m[2]*direction[2];
+   }
+}
+
+void isophoteValues(const unsigned int *normals, int n,
+                    const float direction[3], float *values)
+{
+   int i = 0;
+   float m[3];
+#ifdef __SSE2__
+   __m128 x, y, z;
+   for (; i+4<=n; i+=4) {
+       decode4(normals+i, x, y, z);
+       _mm_storeu_ps(values+i, dot4(x, y, z, direction));
+   }
+#endif
+   for (; i<n; i++) {
+       decodeOctahedral(normals[i], m);
+       values[i] = m[0]*direction[0] + m[1]*direction[1] + m[2]*direction[2];
+   }
+}
+
+void highlightValues(const float *points, const float *normals, int n,
+                     const float linePoint[3], const float lineDirection[3],
+                     float *values)
+{
+   int i = 0;
+   float m[3];
+#ifdef __SSE2__
+   __m128 sx, sy, sz, nx, ny, nz;
+   for (; i+4<=n; i+=4) {
+       load4(points+3*i, sx, sy, sz);
+       load4(normals+3*i, nx, ny, nz);
+       normalize4(nx, ny, nz);
+       _mm_storeu_ps(values+i, highlight4(sx, sy, sz, nx, ny, nz,
+                                          linePoint, lineDirection));
+   }
+#endif
+   for (; i<n; i++) {
+       normalized(normals+3*i, m);
+       values[i] = highlightValue(points+3*i, m, linePoint, lineDirection);
+   }
+}
+
+void highlightValues(const short *points, const Quantization &q,
+                     const unsigned int *normals, int n,
+                     const float linePoint[3], const float lineDirection[3],
+                     float *values)
+{
+   int i = 0;
+   float s[3], m[3];
+#ifdef __SSE2__
+   __m128 sx, sy, sz, nx, ny, nz;
+   for (; i+4<=n; i+=4) {
+       load4(points+3*i, q, sx, sy, sz);
+       decode4(normals+i, nx, ny, nz);
+       _mm_storeu_ps(values+i, highlight4(sx, sy, sz, nx, ny, nz,
+                                          linePoint, lineDirection));
+   }
+#endif
+   for (; i<n; i++) {
+       dequantizePoint(points+3*i, q, s);
+       decodeOctahedral(normals[i], m);
+       values[i] = highlightValue(s, m, linePoint, lineDirection);
+   }
+}
+
+void reflectionValues(const float *points, const float *normals, int n,
+                      const float linePoint[3], const float lineDirection[3],
+                      const float eye[3], float *values)
+{
+   int i = 0;
+   float m[3];
+#ifdef __SSE2__
+   __m128 sx, sy, sz, nx, ny, nz;
+   for (; i+4<=n; i+=4) {
+       load4(points+3*i, sx, sy, sz);
+       load4(normals+3*i, nx, ny, nz);
+       normalize4(nx, ny, nz);
+       _mm_storeu_ps(values+i, reflection4(sx, sy, sz, nx, ny, nz,
+                                           linePoint, lineDirection, eye));
+   }
+#endif
+   for (; i<n; i++) {
+       normalized(normals+3*i, m);
+       values[i] = reflectionValue(points+3*i, m, linePoint, lineDirection, eye);
+   }
+}
+
+void reflectionValues(const short *points, const Quantization &q,
+                      const unsigned int *normals, int n,
+                      const float linePoint[3], const float lineDirection[3],
+                      const float eye[3], float *values)
+{
+   int i = 0;
+   float s[3], m[3];
+#ifdef __SSE2__
+   __m128 sx, sy, sz, nx, ny, nz;
+   for (; i+4<=n; i+=4) {
+       load4(points+3*i, q, sx, sy, sz);
+       decode4(normals+i, nx, ny, nz);
+       _mm_storeu_ps(values+i, reflection4(sx, sy, sz, nx, ny, nz,
+                                           linePoint, lineDirection, eye));
+   }
+#endif
+   for (; i<n; i++) {
+       dequantizePoint(points+3*i, q, s);
+       decodeOctahedral(normals[i], m);
+       values[i] = reflectionValue(s, m, linePoint, lineDirection, eye);
+   }
+}
@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------
+//  ScalarKernels.h
+//
+//  Batch computation of the scalar functions for highlight lines,
+//  reflection lines and isophotes on packed vertex arrays, for float
+//  and for compressed vertex attributes.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef SCALARKERNELS
+#define SCALARKERNELS
+
+//! Quantization of the positions relative to a bounding box
+/*!
+  A coordinate is stored as a signed 16 bit integer q, the position is
+  p = offset + scale*q. The bounding box is mapped onto [-32768, 32767].
+*/
+struct Quantization
+{
+   //! Scale for x, y and z
+   float scale[3];
+   //! Offset for x, y and z
+   float offset[3];
+};
+
+//! Compute the quantization for a bounding box (xmin, xmax, ..., zmax)
+void  computeQuantization(const float box[6], Quantization &q);
+//! Quantize a point
+void  quantizePoint(const float p[3], const Quantization &q, short out[3]);
+//! Decode a quantized point
+void  dequantizePoint(const short in[3], const Quantization &q, float p[3]);
+
+//! Encode a normalized normal with the octahedral mapping into 32 bit
+/*!
+  The normal is projected onto the octahedron |x|+|y|+|z|=1, the lower
+  half is folded over the upper half. The two remaining coordinates are
+  stored as 16 bit signed normalized integers, x in the lower half word.
+*/
+unsigned int encodeOctahedral(const float n[3]);
+//! Decode a normal in octahedral encoding, the result is normalized
+void  decodeOctahedral(unsigned int code, float n[3]);
+
+//! Isophote values <n, d> for n vertices with float normals
+void isophoteValues(const float *normals, int n,
+                    const float direction[3], float *values);
+//! Isophote values <n, d> for n vertices with octahedral normals
+void isophoteValues(const unsigned int *normals, int n,
+                    const float direction[3], float *values);
+
+//! Highlight values for n vertices with float points and normals
+/*!
+  The value is the signed distance (d x n).(p - s) of the light line
+  with point p and direction d and the surface normal line through the
+  surface point s with the normalized normal n, like
+  LightLine::highlightValue().
+*/
+void highlightValues(const float *points, const float *normals, int n,
+                     const float linePoint[3], const float lineDirection[3],
+                     float *values);
+//! Highlight values for n vertices with quantized points and octahedral normals
+void highlightValues(const short *points, const Quantization &q,
+                     const unsigned int *normals, int n,
+                     const float linePoint[3], const float lineDirection[3],
+                     float *values);
+
+//! Reflection values for n vertices with float points and normals
+/*!
+  The value is the signed distance of the light line and the
+  reflected view ray r = 2<n,v>n - v, v = (eye - s)/|eye - s|, through
+  the surface point s.
+*/
+void reflectionValues(const float *points, const float *normals, int n,
+                      const float linePoint[3], const float lineDirection[3],
+                      const float eye[3], float *values);
+//! Reflection values for n vertices with quantized points and octahedral normals
+void reflectionValues(const short *points, const Quantization &q,
+                      const unsigned int *normals, int n,
+                      const float linePoint[3], const float lineDirection[3],
+                      const float eye[3], float *values);
+#endif
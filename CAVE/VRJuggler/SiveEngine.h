@@ -6,8 +6,7 @@
 
 #include "vlgGraphicsEngine.h"
 #include "vlgGetVTKPolyData.h"
-#include "InterrogationObject.h"
-#include "Isophotes.h"
+#include "SiveScene.h"
 
 //! SiveEngine - Anwendungsklasse fr das SIVE-Projekt
 class SiveEngine : public vlgGraphicsEngine
@@ -36,14 +35,8 @@ public:
 // private
 ////
 private:
-	//! Lichtvektor fr die Isophoten
-	LightVector *dir;
-	//! Display-List ID fr den Lichtkfig
-	GLuint cagelist, vectorlist;
-	//! Instanz des untersuchten Objekts
-	InterrogationObject *object;
-	//! Isophoten
-	Isophotes *isophotes;
+	//! Objekt, Isophoten, Lichtkfig und Lichtvektor
+	SiveScene *scene;
 	//! Instanzvariable
 	static SiveEngine* instance;
 	//! Konstruktor
@@ -0,0 +1,244 @@
+// --------------------------------------------------------------------
+//  SiveScene.cpp
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "SiveScene.h"
+#include "MemoryStatus.h"
+#include <iostream>
+using namespace std;
+
+//  Konstruktor
+SiveScene::SiveScene(void) 
+{
+	// Das Objekt wird in ::init() eingelesen
+	object = 0;
+	cubeMap = 0;
+	reflectionLines = false;
+	compactArrays = false;
+	compression = false;
+}
+
+// OpenGL-Zustand der Szene
+void SiveScene::initGL(void)
+{
+	glClearColor(0.5f, 0.5f, 0.5f, 0.5f);
+	glEnable(GL_LIGHTING);
+	glLightModeli(GL_LIGHT_MODEL_LOCAL_VIEWER, GL_TRUE);
+
+        /* Color Tracking anschalten               */
+        glEnable(GL_COLOR_MATERIAL);
+        glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+
+        /* Ambiente Lichtfarbe setzen                  */
+        GLfloat ambientLight[] = {0.1f, 0.1f, 0.1f, 1.0f};
+        /* Diffuse Lichtfarbe setzen                   */
+        GLfloat diffuseLight[] = {1.0f, 1.0f, 1.0f, 1.0f};
+        /* Spekulare Lichtfarbe setzen                 */
+        GLfloat specularLight[] = {0.8f, 0.8f, 0.8f, 1.0f};
+    
+        // Eine Lichtquelle; als Headlight realisieren.
+        glLightfv(GL_LIGHT0, GL_AMBIENT, ambientLight);
+        glLightfv(GL_LIGHT0, GL_DIFFUSE, diffuseLight);
+        glLightfv(GL_LIGHT0, GL_DIFFUSE, specularLight);
+        glEnable(GL_LIGHT0);
+}
+
+// Objekt einlesen, Lichtkfig und Isophoten
+void SiveScene::init(const char *filename)
+{
+	cout << "Einlesen des Objekts und bergabe an OpenGL" << endl;
+
+	printMemoryStatus(cout, "Speicher vor dem Einlesen");
+	// Objekt einlesen, auf Wunsch gepackte Arrays statt VTK-Pipeline.
+	// Der Modus wird vor dem Einlesen gesetzt, es entsteht keine Kopie
+	// der VTK-Daten.
+	object = new InterrogationObject(const_cast<char*>(filename), false,
+	                                 compactArrays);
+	//object->verboseOn();
+	// Das Objekt ist geschlossen, Rckseiten sind verdeckt
+	object->setBackFaceCulling(true);
+	//object->readObject("Data/G2.vtk");
+	//object->readObject("Data/fohe.vtk");
+	//object->readObject("Data/fineMesh.vtk");
+	
+	cout << "Das untersuchte Objekt ist eingelesen und vorbereitet" << endl;
+	printMemoryStatus(cout, "Speicher nach dem Einlesen");
+	if (object->getCompactMode())
+		cout << "Gepackte Arrays: " << object->getMemorySize()/1024
+		     << " kB" << endl;
+
+	cout << "Setzen des Lichtkfigs" << endl;
+	float box[6] = {-2.0f, 2.0f, 0.5f, 4.0f, -2.0f, 2.0f};
+	cage = new TopParallelLightCage(box, 10);
+    
+	cage->setColor(1.0f, 1.0f, 1.0f);
+	// Breite der Lichtbnder fr die Reflexionslinien
+	cage->setCageRadius(0.1f);
+
+	dir = new LightVector(0.0f, 0.0f, 1.0f);
+
+	float *boundingbox = new float[6];
+	boundingbox = object->getBoundingBox();
+	float delta = 0.5f*(boundingbox[3]-boundingbox[2]);
+        float w[3];
+	w[0] = 0.5f*(boundingbox[0]+boundingbox[1]);
+	w[1] = boundingbox[3] + 0.1f*delta;
+	w[2] = 0.5f*(boundingbox[4]+boundingbox[5]);
+
+	dir->setRenderOrigin(w);
+	dir->setLength(2.0f*delta);
+	dir->setColor(1.0f, 1.0f, 0.0f);
+
+	// Lichtkfig und Lichtvektor in einem Buffer, der nur nach
+	// nderungen neu geschrieben wird. Der Kfig ist zunchst
+	// ausgeblendet, Taste 'c'.
+	cageRenderer = new CageRenderer(cage, dir);
+	cageRenderer->showCage(false);
+	// Breite Linien als Quads, glLineWidth wird von vielen Treibern
+	// auf 1 Pixel begrenzt
+	cageRenderer->setLineWidth(4.0f);
+
+	// Environment-Map des Kfigs fr die Reflexionslinien, vom
+	// Mittelpunkt des Objekts aus gesehen, Taste 'r'
+	cubeMap = new CubeMapGenerator(cage, 256);
+	cubeMap->setOrigin(0.5f*(boundingbox[0]+boundingbox[1]),
+	                   0.5f*(boundingbox[2]+boundingbox[3]),
+	                   0.5f*(boundingbox[4]+boundingbox[5]));
+
+	cout << "Der Lichtkfig ist gesetzt" << endl;
+	cout << endl;
+
+	cout << "Die Isophoten werden initialisiert" << endl;
+	isophotes = new Isophotes(object, dir);
+	// Die Segmente werden in Chunks aufgeteilt, jeder Kanal zeichnet
+	// nur die sichtbaren Chunks, weit entfernte vereinfacht.
+	isophotes->getContourEngine()->setChunks(true);
+	isophotes->getContourEngine()->setLineWidth(5.0f);
+	isophotes->getContourEngine()->getLineChunks()->setBackFaceCulling(true);
+	cout << "Die Isophoten werden berechnet" << endl;
+			
+
+	if (!object->getCompactMode()) {
+		isophotes->doAttributes();
+		isophotes->doPointData();
+		isophotes->doLines();
+		isophotes->processData();
+		isophotes->setPointer();
+	}
+
+	// Komprimierte Vertex-Attribute, Genauigkeit gegen die
+	// float-Arrays pruefen und diese dann freigeben.
+	if (object->getCompactMode() && compression) {
+		object->compress();
+		isophotes->compareCompression(cout);
+		object->releaseFloatArrays();
+		cout << "Komprimierte Arrays: " << object->getMemorySize()/1024
+		     << " kB" << endl;
+	}
+
+	isophotes->compute();
+	printMemoryStatus(cout, "Speicher nach der Berechnung");
+	if (object->getCompactMode())
+		cout << "Isophoten: " << isophotes->getMemorySize()/1024
+		     << " kB" << endl;
+	cout << "Initialisierung abgeschlossen" << endl;
+}
+
+// Darstellung der Szene
+void SiveScene::draw(void)
+{
+	glEnable(GL_LIGHTING);
+        GLfloat light0Pos[] = {2.0f, 6.0f, 2.0f, 0.0f};
+        glLightfv(GL_LIGHT0, GL_POSITION, light0Pos);
+
+	// Die Vertex-Arrays gehoeren nur der Szene
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_NORMAL_ARRAY);
+
+	glPushMatrix();
+	    glColor3fv(object->getColor());
+	    if (reflectionLines) {
+		// Die Farbe des Objekts wird mit der Leuchtdichte
+		// moduliert; nur nach nderungen neu berechnen
+		cubeMap->update();
+		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+		cubeMap->enable();
+		object->draw();
+		cubeMap->disable();
+	    }
+	    else
+		object->draw();
+	    
+ 	    glDisable(GL_LIGHTING);
+	    // glLineWidth gilt nur noch, wenn keine Quads verwendet werden
+	    glLineWidth(4.0f);
+	    // Fr Isophoten wird der Lichtvektor dargestellt
+	    cageRenderer->draw();
+
+	    glLineWidth(5.0f);
+	    glColor3f(1.0f, 1.0f, 1.0f);
+	    if (!reflectionLines) isophotes->draw();
+
+	    glEnable(GL_LIGHTING);
+	glPopMatrix();
+	glPopClientAttrib();
+}
+
+void SiveScene::setReflectionLines(bool r)
+{
+	reflectionLines = r;
+}
+
+bool SiveScene::getReflectionLines(void)
+{
+	return reflectionLines;
+}
+
+void SiveScene::setCompactArrays(bool c)
+{
+	compactArrays = c;
+}
+
+bool SiveScene::getCompactArrays(void)
+{
+	return compactArrays;
+}
+
+void SiveScene::setCompression(bool c)
+{
+	compression = c;
+}
+
+bool SiveScene::getCompression(void)
+{
+	return compression;
+}
+
+float* SiveScene::getBoundingBox(void)
+{
+	return object->getBoundingBox();
+}
+
+CageRenderer* SiveScene::getCageRenderer(void)
+{
+	return cageRenderer;
+}
+
+Isophotes* SiveScene::getIsophotes(void)
+{
+	return isophotes;
+}
+
+InterrogationObject* SiveScene::getInterrogationObject(void)
+{
+	return object;
+}
+
+CubeMapGenerator* SiveScene::getCubeMapGenerator(void)
+{
+	return cubeMap;
+}
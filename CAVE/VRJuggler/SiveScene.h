@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------
+//  SiveScene.h
+//
+//  The scene of SIVE/GL without a window: the interrogated object, the
+//  isophotes, the light cage and the light vector.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef SIVESCENE
+#define SIVESCENE
+
+#include "InterrogationObject.h"
+#include "Isophotes.h"
+#include "TopParallelLightCage.h"
+#include "CageRenderer.h"
+#include "CubeMapGenerator.h"
+
+//! Die Szene von SIVE/GL, unabhngig vom Fenster
+/*!
+  Die Szene braucht nur einen gltigen OpenGL-Kontext und keine
+  GLUT-Funktionen. SiveEngine verwendet sie im GLUT-Fenster,
+  siveHeadless in einem OSMesa-Kontext ohne Fenster, um die Zeit
+  fr ::draw() zu messen und Bilder zu vergleichen.
+*/
+class SiveScene
+{
+////
+// public
+////
+public:
+	//! Konstruktor, das Objekt wird erst in ::init() eingelesen
+	SiveScene(void);
+
+	//! OpenGL-Zustand: Hintergrund, Beleuchtung, Color Tracking
+	void initGL(void);
+	//! Objekt einlesen, Lichtkfig setzen und Isophoten berechnen
+	/*!
+	  Ohne ::setCompactArrays() wird das Objekt wie bisher ber die
+	  VTK-Pipeline eingelesen und dargestellt.
+	*/
+	void init(const char *filename);
+
+	//! Die Szene darstellen, die Kamera ist auf dem Modelview-Stack
+	void draw(void);
+
+	//! Reflexionslinien statt Isophoten darstellen
+	/*!
+	  Das Objekt wird mit der Cube-Map des Lichtkfigs als
+	  Environment-Map texturiert, die Isophoten werden nicht
+	  dargestellt. Die Cube-Map wird nur nach nderungen des
+	  Lichtkfigs neu berechnet.
+	*/
+	void setReflectionLines(bool);
+	//! Werden Reflexionslinien dargestellt?
+	bool getReflectionLines(void);
+
+	//! Das Objekt mit gepackten Arrays statt VTK-Daten einlesen
+	/*!
+	  Muss vor ::init() aufgerufen werden, Vorgabe ist false.
+	*/
+	void setCompactArrays(bool);
+	//! Werden gepackte Arrays verwendet?
+	bool getCompactArrays(void);
+	//! Die gepackten Arrays komprimieren und die float-Arrays freigeben
+	/*!
+	  Wirkt nur mit gepackten Arrays und muss vor ::init() aufgerufen
+	  werden, Vorgabe ist false.
+	*/
+	void setCompression(bool);
+	//! Werden die Vertex-Attribute komprimiert?
+	bool getCompression(void);
+
+	//! Bounding-Box des Objekts (xmin, xmax, ymin, ymax, zmin, zmax)
+	float* getBoundingBox(void);
+	//! Der Renderer fr Lichtkfig und Lichtvektor
+	CageRenderer* getCageRenderer(void);
+	//! Die Isophoten, z.B. fr die Statistik der Chunks
+	Isophotes* getIsophotes(void);
+	//! Das untersuchte Objekt
+	InterrogationObject* getInterrogationObject(void);
+	//! Die Cube-Map des Lichtkfigs fr die Reflexionslinien
+	CubeMapGenerator* getCubeMapGenerator(void);
+////
+// private
+////
+private:
+	//! Lichtvektor fr die Isophoten
+	LightVector *dir;
+	//! Lichtkfig
+	TopParallelLightCage *cage;
+	//! Lichtkfig und Lichtvektor in einem Vertex-Buffer
+	CageRenderer *cageRenderer;
+	//! Instanz des untersuchten Objekts
+	InterrogationObject *object;
+	//! Isophoten
+	Isophotes *isophotes;
+	//! Cube-Map des Lichtkfigs fr die Reflexionslinien
+	CubeMapGenerator *cubeMap;
+	//! Reflexionslinien statt Isophoten?
+	bool reflectionLines;
+	//! Gepackte Arrays statt VTK-Daten?
+	bool compactArrays;
+	//! Komprimierte Vertex-Attribute?
+	bool compression;
+};
+#endif /* SIVESCENE */
@@ -2,7 +2,7 @@
 //  TopParallelLightCage.cpp
 //  
 //  Implementation file:
-//  A STL container (list) for parallel LightLines in the topplane
+//  A light cage of parallel LightLines in the topplane
 //  of the interrogated object.
 // --------------------------------------------------------------------
 //  $RCSfile$
@@ -10,6 +10,7 @@
 //  $Date$
 // --------------------------------------------------------------------
 #include <cmath>
+#include <algorithm>
 
 #include <GL/glu.h>
 
@@ -30,11 +31,13 @@ TopParallelLightCage::TopParallelLightCage(void)
    attenuation = LightLine::Constant;
    radius = 0.0f;
    preFilterMap = false;
+   overlap = Maximum;
+   indexRevision = 0;
 }
 
 TopParallelLightCage::TopParallelLightCage(const TopParallelLightCage& copy)
 {
-   cage = copy.cage;
+   copyCage(copy);
    for (int i=0; i<6; i++) 
       BBox[i] = copy.BBox[i];
 
@@ -43,14 +46,13 @@ TopParallelLightCage::TopParallelLightCage(const TopParallelLightCage& copy)
    centerx = copy.centerx; centery = copy.centery; centerz = copy.centerz;
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
-   attenuation = copy.attenuation;
-   radius = copy.radius;
-   preFilterMap = copy.preFilterMap;
+   overlap = copy.overlap;
+   indexRevision = 0;
 }
 
 TopParallelLightCage::TopParallelLightCage(TopParallelLightCage *copy)
 {
-   cage = copy->cage;
+   copyCage(*copy);
    for (int i=0; i<6; i++) 
       BBox[i] = copy->BBox[i];
 
@@ -59,9 +61,8 @@ TopParallelLightCage::TopParallelLightCage(TopParallelLightCage *copy)
    centerx = copy->centerx; centery = copy->centery; centerz = copy->centerz;
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
-   attenuation = copy->attenuation;
-   radius = copy->radius;
-   preFilterMap = copy->preFilterMap;
+   overlap = copy->overlap;
+   indexRevision = 0;
 }
 
 // Just one lightline, centered, parallel to z. We elevate the
@@ -83,6 +84,8 @@ TopParallelLightCage::TopParallelLightCage(float box[6])
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
    preFilterMap=false;
+   overlap = Maximum;
+   indexRevision = 0;
 }
 
 
@@ -113,6 +116,8 @@ TopParallelLightCage::TopParallelLightCage(float box[6], int number)
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
    preFilterMap=false;
+   overlap = Maximum;
+   indexRevision = 0;
 }
 
 
@@ -158,6 +163,8 @@ TopParallelLightCage::TopParallelLightCage(float box[6], bool vertical)
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
    preFilterMap=false;
+   overlap = Maximum;
+   indexRevision = 0;
 }
 
 // Construct a set of lightlines, parallel to y, if vertical is true; parallel
@@ -228,6 +235,8 @@ TopParallelLightCage::TopParallelLightCage(float box[6], bool vertical,
    normal[0] = normal[1] = 0.0f;
    normal[2] = 1.0f;
    preFilterMap=false;
+   overlap = Maximum;
+   indexRevision = 0;
 }
 
 float* TopParallelLightCage::getBBox(void)
@@ -279,23 +288,45 @@ void TopParallelLightCage::getCenterOfBBox(Vector3 &center)
 // Pure virtual function in base class!
 float TopParallelLightCage::luminance(Vector3 ray)
 {
-   bool bang=true;
-   float value = 0.0f;
-
-   list<LightLine>::iterator iter = cage.begin();
-   list<LightLine>::iterator end = cage.end();
+   int i, j, n = size(), first = 0, last = n-1;
+   float value = 0.0f, lo, hi, help, h[3], c;
+   const float *p, *d;
 
    // We have to transform the ray to world coordinates:
    // we translate
    // with getCenterOfBBox() and scale with
    // transformVectorToBBox().
-   Vector3 center(centerx, centery, centerz),
-           worldray(ray.getX()*xs, ray.getY()*ys, ray.getZ()*zs);
-   
-   while ((iter != end) && bang) {
-     value = iter->luminance(center, worldray);
-     if (value != 0.0f) bang = !bang;
-     ++iter;
+   float worldray[3] = {ray.getX()*xs, ray.getY()*ys, ray.getZ()*zs};
+
+   if (n == 0) return 0.0f;
+   updateIndex();
+
+   // For parallel lines the perpendicular distance (d x ray).(p - center)
+   // is h[lui]*key + c, so only lines with a key in the interval where
+   // this is at most maxRadius can be hit.
+   d = &directions[0];
+   h[0] = d[1]*worldray[2] - d[2]*worldray[1];
+   h[1] = d[2]*worldray[0] - d[0]*worldray[2];
+   h[2] = d[0]*worldray[1] - d[1]*worldray[0];
+   if (parallel && (fabsf(h[lui]) > 1.0E-8)) {
+      p = &points[0];
+      c = h[0]*(p[0]-centerx) + h[1]*(p[1]-centery) + h[2]*(p[2]-centerz)
+        - h[lui]*p[lui];
+      lo = (-maxRadius - c)/h[lui];
+      hi = ( maxRadius - c)/h[lui];
+      if (lo > hi) {help = lo; lo = hi; hi = help;}
+      findLines(lo, hi, first, last);
+   }
+
+   for (j=first; j<=last; j++) {
+     i = order[j];
+     p = &points[3*i]; d = &directions[3*i];
+     h[0] = d[1]*worldray[2] - d[2]*worldray[1];
+     h[1] = d[2]*worldray[0] - d[0]*worldray[2];
+     h[2] = d[0]*worldray[1] - d[1]*worldray[0];
+     value = combine(value, 
+                     attenuate((h[0]*(p[0]-centerx) + h[1]*(p[1]-centery) +
+                                h[2]*(p[2]-centerz))/(double)radii[i], attenuations[i]));
    }
    return value;
 }
@@ -309,16 +340,16 @@ float TopParallelLightCage::luminance(Vector3 ray)
 // the second parameter.
 float TopParallelLightCage::luminance(float c, float d)
 {
-   bool bang=true;
+   int i, j, first, last;
    float value = 0.0f;
 
-   list<LightLine>::iterator iter = cage.begin();
-   list<LightLine>::iterator end = cage.end();
+   updateIndex();
 
-   while ((iter != end) && bang) {
-     value = iter->luminance(lui, c);
-     if (value != 0.0f) bang = !bang;
-     ++iter;
+   // only lines closer than the maximal radius contribute
+   findLines(c - maxRadius, c + maxRadius, first, last);
+   for (j=first; j<=last; j++) {
+     i = order[j];
+     value = combine(value, attenuate(fabs(keys[j]-c)/(double)radii[i], attenuations[i]));
    }
    return value;
 }
@@ -330,51 +361,29 @@ float TopParallelLightCage::luminance(float c, float d)
 // Remember, that the size in int has to be a power of 2!
 vlgTextureMap1D* TopParallelLightCage::computeTexture(int size)
 {
-   int i, localSize, vh=1;
+   int i;
    vlgTextureMap1D *tex = new vlgTextureMap1D;
-   float clr[4];
-
-   float c, h, d=0.0f;
+   float lo, h, value;
 
-   if (preFilterMap) 
-      localSize = 4*size;
-   else
-      localSize = size;
-
-   unsigned short* image = new unsigned short[localSize];
+   // texel i covers [lo + i*h, lo + (i+1)*h], like the texture coordinates
    if (lui == 0) {
-      h = (BBox[1]-BBox[0])/(size-1);
-      c = BBox[0] + h/2.0f;
+      lo = BBox[0];
+      h = (BBox[1]-BBox[0])/size;
    }
-   else if (lui == 1) {
-      h = (BBox[3]-BBox[2])/(size-1);
-      c = BBox[2] + h/2.0f;
+   else {
+      lo = BBox[2];
+      h = (BBox[3]-BBox[2])/size;
    }
 
-
    // 1D!
-   for (i=0; i<localSize; i++) {
-        // We get back floats, so we have to do a cast.
-        image[i] = (unsigned short)(this->luminance(c,d)*65535.0f);
-
-        // Update the point coordinate c
-        c += h;
-   }
-
-   // Do the preFilter
-   if (preFilterMap) {
-        unsigned short* filteredImage = new unsigned short[size];
-  
-        preFilter(vh, size, image, filteredImage);
-
-        // Store the texture 
-	for (i=0; i<size; i++)
-		tex->setPixel(i, image[i]);
+   for (i=0; i<size; i++) {
+        if (preFilterMap)
+           value = averageLuminance(lo + i*h, lo + (i+1)*h);
+        else
+           value = this->luminance(lo + (i+0.5f)*h, 0.0f);
 
-   }
-   else {
-	for (i=0; i<size; i++)
-		tex->setPixel(i, image[i]);
+        // We get back floats, so we have to do a cast.
+        tex->setPixel(i, (unsigned short)(value*65535.0f));
    }
 
    return tex;
@@ -424,13 +433,7 @@ void TopParallelLightCage::getCageNormal(float x, float n[3])
 // Transform the lightcage
 void TopParallelLightCage::translate(float x, float y, float z)
 {
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   while (iter != end) {
-      iter->translate(x,y,z);
-      ++iter;
-   }
+   translateLines(x,y,z);
 
    // translating the BBox
    BBox[0] += x;
@@ -454,13 +457,7 @@ void TopParallelLightCage::rotateX(float degrees)
    // read the new values from that. 
    Vector3 vector;
 
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   while (iter != end) {
-      iter->rotateX(degrees);
-      ++iter;
-   }
+   rotateLines(0, degrees);
 
    vector.set(BBox[0], BBox[2], BBox[4]);
    vector.rotateX(degrees);
@@ -491,13 +488,7 @@ void TopParallelLightCage::rotateY(float degrees)
    // read the new values from that. 
    Vector3 vector;
 
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   while (iter != end) {
-      iter->rotateY(degrees);
-      ++iter;
-   }
+   rotateLines(1, degrees);
 
    vector.set(BBox[0], BBox[2], BBox[4]);
    vector.rotateY(degrees);
@@ -528,13 +519,7 @@ void TopParallelLightCage::rotateZ(float degrees)
    // read the new values from that. 
    Vector3 vector;
 
-   list<LightLine>::iterator iter=cage.begin();
-   list<LightLine>::iterator end = cage.end();
-
-   while (iter != end) {
-      iter->rotateZ(degrees);
-      ++iter;
-   }
+   rotateLines(2, degrees);
 
    vector.set(BBox[0], BBox[2], BBox[4]);
    vector.rotateZ(degrees);
@@ -576,24 +561,89 @@ void TopParallelLightCage::setBBox(float box[6])
    centerz = 0.5f * (BBox[4] + BBox[5]);
 }
 
-void TopParallelLightCage::preFilter(int vh, int size,
-                                        unsigned short *bigImage,
-                                        unsigned short *smallImage)
+// build the sorted index of the lines
+void TopParallelLightCage::updateIndex(void)
 {
-   int i,j, k, l, sub=4, superSize = sub*size;
-   unsigned short sample, weightSum=20;
-
-   unsigned short filterKernel[4][4] = {1,1,1,1,1,2,2,1,1,2,2,1,1,1,1,1};
-
-   for (j=0; j< vh; j++)
-   for (i=0; i< size; i++) {
-       sample = 0;
-       // Supersample
-       for (l=j*sub; l<(j+1)*sub; l++)
-       for (k=i*sub; k<(i+1)*sub; k++) {
-            sample += filterKernel[l-j*sub][k-i*sub]*bigImage[l*superSize+k];
-       }
+   int i, k, n = size();
+   vector< pair<float,int> > sorted;
+   const float *p0, *d0;
+
+   // called for every texel, the check has to be O(1)
+   if (indexRevision == revision) return;
+
+   sorted.reserve(n);
+   for (i=0; i<n; i++) 
+      sorted.push_back(pair<float,int>(points[3*i+lui], i));
+   sort(sorted.begin(), sorted.end());
+
+   order.resize(n);
+   keys.resize(n);
+   maxRadius = 0.0f;
+   for (i=0; i<n; i++) {
+      keys[i]  = sorted[i].first;
+      order[i] = sorted[i].second;
+      if (radii[i] > maxRadius) maxRadius = radii[i];
+   }
+
+   // the lines have to share the direction and differ in coordinate lui only
+   parallel = true;
+   if (n > 0) {
+      p0 = &points[0]; d0 = &directions[0];
+      for (i=1; (i<n) && parallel; i++)
+      for (k=0; k<3; k++) {
+         if (fabsf(directions[3*i+k] - d0[k]) > 1.0E-6) parallel = false;
+         if ((k != lui) && (fabsf(points[3*i+k] - p0[k]) > 1.0E-6)) parallel = false;
+      }
+   }
 
-       smallImage[j*size+i] = sample/weightSum;
+   // equidistant keys allow a direct lookup of the slot
+   spacing = 0.0f;
+   if (n > 1) {
+      spacing = (keys[n-1] - keys[0])/(n-1);
+      for (i=1; (i<n-1) && (spacing > 0.0f); i++)
+         if (fabsf(keys[i] - (keys[0] + i*spacing)) > 1.0E-4*spacing) spacing = 0.0f;
    }
+
+   indexRevision = revision;
+}
+
+// positions [first, last] in the index with key in [lo, hi].
+// For equidistant keys the range may contain one more line
+// at both ends, the luminance of these lines is 0.
+void TopParallelLightCage::findLines(float lo, float hi, int &first, int &last)
+{
+   int n = keys.size();
+
+   first = 0; last = -1;
+   if ((n == 0) || (hi < keys[0]) || (lo > keys[n-1])) return;
+
+   if (spacing > 0.0f) {
+      first = (lo <= keys[0])   ? 0   : (int)floor((lo - keys[0])/spacing);
+      last  = (hi >= keys[n-1]) ? n-1 : (int)ceil((hi - keys[0])/spacing);
+   }
+   else {
+      first = lower_bound(keys.begin(), keys.end(), lo) - keys.begin();
+      last  = upper_bound(keys.begin(), keys.end(), hi) - keys.begin() - 1;
+   }
+}
+
+// Mean luminance over [lo, hi]. For every line the exact mean of its
+// light form is used. The lines are combined after filtering, which
+// is exact for the additive combination as long as the sum stays below
+// the clamp at 1, and for the maximum if the texel touches only one
+// band.
+float TopParallelLightCage::averageLuminance(float lo, float hi)
+{
+   int i, j, first, last;
+   float value = 0.0f;
+
+   updateIndex();
+
+   findLines(lo - maxRadius, hi + maxRadius, first, last);
+   for (j=first; j<=last; j++) {
+     i = order[j];
+     value = combine(value, boxFilter((lo-keys[j])/(double)radii[i],
+                                      (hi-keys[j])/(double)radii[i], attenuations[i]));
+   }
+   return value;
 }
@@ -1,6 +1,6 @@
 // --------------------------------------------------------------------
 //  TopParallelLightCage
-//  A STL container (list) for LightLines. We handle the special
+//  A light cage with LightLines. We handle the special
 //  case of parallel lightlines, in a plane parallel to the top plane
 //  of the bounding box.
 // --------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #ifndef TOPPARALLELIGHTCAGE
 #define TOPPARALLELIGHTCAGE
 #include <list>
+#include <vector>
 
 #include "vlgTextureMap1D.h"
 #include "LightCage.h"
@@ -28,6 +29,17 @@ class TopParallelLightCage : public LightCage
 // public
 // ----------------------------------------------
 public: 
+   //! enum Overlap.
+   /*!
+     enum Overlap
+     Combination of the luminance of overlapping light cylinders:
+        - Maximum, the brightest cylinder wins,
+        - Additive, the luminance values are added, clamped to 1.
+
+     The default value is Maximum.
+   */
+   enum Overlap {Maximum, Additive};
+
    //! Default Constructur
    /*!
      Default Constructor. The bounding box is set to [-1,1]^3; the plane
@@ -87,9 +99,9 @@ public:
      Compute the luminance, given the lookup-vector ray.
      ray is assumed to be in texture space [-1,1]^3. 
 
-     It is assumed that the light cylinders do not overlap. That
-     could be handeled. But the first hit (luminance >0 for a line)
-     stops the computation.
+     Only the lines near the ray are evaluated, using the sorted index
+     of the lines. Overlapping light cylinders are combined as
+     given by ::setOverlap().
    */
    virtual float luminance(Vector3 ray);
    // compute the luminance, given the coordinates of a 
@@ -103,12 +115,21 @@ public:
    */
    virtual float luminance(float, float);
 
+   //! Set the combination of overlapping light cylinders
+   inline void setOverlap(Overlap o) {overlap = o;}
+   //! Query the combination of overlapping light cylinders
+   inline Overlap getOverlap(void) {return overlap;}
+
    //! Compute the texture map representing the light cage
    /*!
       Compute a texture map representing the light cage. 
       This class represents parallel light lines, so
       we use a one-dimensional texture. 
 
+      With prefiltering on every texel is the exact mean of the
+      luminance over the texel, using the integral of the light form.
+      Without prefiltering the luminance is sampled in the texel center.
+
       The size in int has to be a power of 2!
    */
    virtual vlgTextureMap1D* computeTexture(int);
@@ -195,11 +216,40 @@ private:
    */
    int lui;
 
+   //! Combination of overlapping light cylinders
+   Overlap overlap;
+
+   // sorted index of the lines
+   //! Line indices, sorted by the line point coordinate lui
+   vector<int> order;
+   //! Sorted line point coordinates lui
+   vector<float> keys;
+   //! Distance of the keys, if they are equidistant, else 0
+   float spacing;
+   //! Maximal radius of the lines
+   float maxRadius;
+   //! Are the lines parallel and differ only in coordinate lui?
+   /*!
+     If not, the index can not be used for ::luminance(Vector3) and
+     all lines are evaluated.
+   */
+   bool  parallel;
+   //! Revision of the lines the index is built for
+   unsigned int indexRevision;
+
+   // build the index again, if the lines have changed
+   void updateIndex(void);
+   // positions [first, last] in the index with key in [lo, hi]
+   void findLines(float lo, float hi, int &first, int &last);
+   // combine the luminance of a line with the value of other lines
+   inline float combine(float value, float line)
+       {if (overlap == Additive) return (value+line > 1.0f) ? 1.0f : value+line;
+        else return (line > value) ? line : value;}
+
    // compound function to set all bbox related variables
    void setBBox(float box[6]);
 
-   // preFilter function for texture maps
-   void preFilter(int vh, int size, unsigned short *bigImage,
-                                    unsigned short *smallImage);
+   // mean luminance over [lo, hi] in coordinate lui, for prefiltered textures
+   float averageLuminance(float lo, float hi);
 };
 #endif
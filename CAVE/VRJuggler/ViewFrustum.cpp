@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------
+//  ViewFrustum.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "ViewFrustum.h"
+
+#include <math.h>
+
+ViewFrustum::ViewFrustum(void)
+{
+   int i, k;
+
+   for (i=0; i<16; i++) modelview[i] = (i%5 == 0) ? 1.0f : 0.0f;
+   // the cube [-1,1]^3 of the identity projection
+   for (i=0; i<6; i++) {
+       for (k=0; k<3; k++) planes[i][k] = 0.0f;
+       planes[i][i/2] = (i%2 == 0) ? 1.0f : -1.0f;
+       planes[i][3] = 1.0f;
+   }
+   eye[0] = eye[1] = eye[2] = 0.0f;
+   pixels = 1.0f;
+   perspective = false;
+}
+
+void ViewFrustum::read(void)
+{
+   GLfloat *mv = modelview, p[16], clip[16];
+   GLint viewport[4];
+   float inverse[3][3], det;
+   int i, k;
+
+   glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+   glGetFloatv(GL_PROJECTION_MATRIX, p);
+   glGetIntegerv(GL_VIEWPORT, viewport);
+
+   // the planes in object coordinates (Gribb, Hartmann)
+   for (i=0; i<4; i++)
+       for (k=0; k<4; k++)
+           clip[4*i+k] = p[k]*mv[4*i] + p[4+k]*mv[4*i+1] +
+                         p[8+k]*mv[4*i+2] + p[12+k]*mv[4*i+3];
+   for (k=0; k<4; k++) {
+       planes[0][k] = clip[4*k+3] + clip[4*k];
+       planes[1][k] = clip[4*k+3] - clip[4*k];
+       planes[2][k] = clip[4*k+3] + clip[4*k+1];
+       planes[3][k] = clip[4*k+3] - clip[4*k+1];
+       planes[4][k] = clip[4*k+3] + clip[4*k+2];
+       planes[5][k] = clip[4*k+3] - clip[4*k+2];
+   }
+
+   // the eye, -R^-1 t for the modelview matrix (R, t)
+   inverse[0][0] = mv[5]*mv[10] - mv[9]*mv[6];
+   inverse[0][1] = mv[8]*mv[6]  - mv[4]*mv[10];
+   inverse[0][2] = mv[4]*mv[9]  - mv[8]*mv[5];
+   inverse[1][0] = mv[9]*mv[2]  - mv[1]*mv[10];
+   inverse[1][1] = mv[0]*mv[10] - mv[8]*mv[2];
+   inverse[1][2] = mv[8]*mv[1]  - mv[0]*mv[9];
+   inverse[2][0] = mv[1]*mv[6]  - mv[5]*mv[2];
+   inverse[2][1] = mv[4]*mv[2]  - mv[0]*mv[6];
+   inverse[2][2] = mv[0]*mv[5]  - mv[4]*mv[1];
+   det = mv[0]*inverse[0][0] + mv[4]*inverse[1][0] + mv[8]*inverse[2][0];
+   for (i=0; i<3; i++) {
+       eye[i] = 0.0f;
+       for (k=0; k<3; k++) eye[i] -= inverse[i][k]*mv[12+k];
+       if (det != 0.0f) eye[i] /= det;
+   }
+
+   perspective = (p[11] != 0.0f);
+   pixels = 0.5f*viewport[3]*p[5];
+}
+
+// Outside, if the corner farthest in the direction of a normal is outside
+bool ViewFrustum::isOutside(const float box[6]) const
+{
+   float d;
+   int i, k;
+
+   for (i=0; i<6; i++) {
+       d = planes[i][3];
+       for (k=0; k<3; k++)
+           d += planes[i][k]*((planes[i][k] > 0.0f) ? box[2*k+1] : box[2*k]);
+       if (d < 0.0f) return true;
+   }
+   return false;
+}
+
+float ViewFrustum::distance(const float box[6]) const
+{
+   float d, dist = 0.0f;
+   int k;
+
+   for (k=0; k<3; k++) {
+       if (eye[k] < box[2*k])        d = box[2*k]-eye[k];
+       else if (eye[k] > box[2*k+1]) d = eye[k]-box[2*k+1];
+       else                          d = 0.0f;
+       dist += d*d;
+   }
+   return sqrt(dist);
+}
+
+float ViewFrustum::pixelSize(float distance) const
+{
+   if (pixels <= 0.0f) return 0.0f;
+   return perspective ? distance/pixels : 1.0f/pixels;
+}
+
+// The depth is the z coordinate in eye coordinates, the third row of
+// the modelview matrix.
+float ViewFrustum::pixelSize(const float p[3]) const
+{
+   float depth = -(modelview[2]*p[0] + modelview[6]*p[1] +
+                   modelview[10]*p[2] + modelview[14]);
+
+   return pixelSize((depth > 0.0f) ? depth : 0.0f);
+}
+
+// For a parallel projection the direction is the z axis of the eye
+// coordinates.
+void ViewFrustum::toViewer(const float p[3], float v[3]) const
+{
+   int k;
+
+   if (perspective)
+      for (k=0; k<3; k++) v[k] = eye[k]-p[k];
+   else
+      for (k=0; k<3; k++) v[k] = modelview[4*k+2];
+}
+
+const float* ViewFrustum::getEye(void) const
+{
+   return eye;
+}
+
+bool ViewFrustum::isPerspective(void) const
+{
+   return perspective;
+}
@@ -0,0 +1,76 @@
+// --------------------------------------------------------------------
+//  ViewFrustum.h
+//
+//  The view of the current OpenGL matrices in object coordinates:
+//  frustum planes, eye point and the size of a pixel.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef VIEWFRUSTUM
+#define VIEWFRUSTUM
+
+#include <GL/gl.h>
+
+//! The view of the current OpenGL matrices in object coordinates
+/*!
+  ::read() takes the modelview and projection matrix and the viewport
+  of the current context. The frustum planes are extracted from the
+  product of the matrices (Gribb, Hartmann), the eye is the origin of
+  the eye coordinates transformed back with the modelview matrix.
+
+  The size of a pixel in object units depends on the depth of a point
+  for a perspective projection, for a parallel projection it is
+  constant. Classes with view dependent rendering, like \link LineChunks
+  \endlink and \link WideLines \endlink, read the view once per draw.
+*/
+class ViewFrustum
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, the identity view
+   ViewFrustum(void);
+
+   //! Read the current matrices and the viewport
+   void read(void);
+
+   //! Is the box (xmin, xmax, ymin, ymax, zmin, zmax) outside of the frustum?
+   /*!
+     The test is conservative, a box near a corner of the frustum may
+     be inside although it is not visible.
+   */
+   bool isOutside(const float box[6]) const;
+   //! Distance of the eye to the box, 0 if the eye is inside
+   float distance(const float box[6]) const;
+
+   //! Size of a pixel in object units at a distance from the eye
+   float pixelSize(float distance) const;
+   //! Size of a pixel in object units at the depth of a point
+   float pixelSize(const float p[3]) const;
+   //! Direction from the point to the viewer, not normalized
+   void  toViewer(const float p[3], float v[3]) const;
+
+   //! Query the eye point
+   const float* getEye(void) const;
+   //! Is the projection perspective?
+   bool  isPerspective(void) const;
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! The modelview matrix
+   GLfloat modelview[16];
+   //! The planes of the frustum, the normals point inside
+   float planes[6][4];
+   //! The eye point
+   float eye[3];
+   //! Pixels per object unit at depth 1, or for a parallel projection
+   float pixels;
+   //! Is the projection perspective?
+   bool  perspective;
+};
+#endif
@@ -0,0 +1,166 @@
+// --------------------------------------------------------------------
+//  WideLines.cpp
+//
+//  Implementation
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#include "WideLines.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#include "BufferObjects.h"
+
+static inline GLubyte colorByte(float c)
+{
+   if (c <= 0.0f) return 0;
+   if (c >= 1.0f) return 255;
+   return (GLubyte) (255.0f*c + 0.5f);
+}
+
+WideLines::WideLines(void)
+{
+   width = 1.0f;
+   color[0] = color[1] = color[2] = color[3] = 255;
+   quads = 0;
+
+   initialized = false;
+   buffer = 0;
+
+   drawCalls = 0;
+}
+
+WideLines::~WideLines(void)
+{
+   if (buffer != 0) deleteBuffers(1, &buffer);
+}
+
+void WideLines::setWidth(float w)
+{
+   width = (w < 0.0f) ? 0.0f : w;
+}
+
+float WideLines::getWidth(void)
+{
+   return width;
+}
+
+void WideLines::setColor(const GLfloat c[4])
+{
+   for (int i=0; i<4; i++) color[i] = colorByte(c[i]);
+}
+
+void WideLines::setColor(const GLubyte c[4])
+{
+   for (int i=0; i<4; i++) color[i] = c[i];
+}
+
+void WideLines::begin(void)
+{
+   view.read();
+   vertices.clear();
+}
+
+// The side vector is orthogonal to the segment and to the direction
+// to the viewer, for both end points, since the segment is in the
+// plane of the directions of its end points.
+void WideLines::addSegment(const float p[3], const float q[3])
+{
+   float d[3], v[3], side[3], len, sideLen, hp, hq;
+   int k;
+
+   for (k=0; k<3; k++) d[k] = q[k]-p[k];
+   len = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+   if (len == 0.0f) return;
+
+   view.toViewer(p, v);
+   side[0] = d[1]*v[2] - d[2]*v[1];
+   side[1] = d[2]*v[0] - d[0]*v[2];
+   side[2] = d[0]*v[1] - d[1]*v[0];
+   sideLen = sqrt(side[0]*side[0] + side[1]*side[1] + side[2]*side[2]);
+   // seen end-on, the segment is not visible
+   if (sideLen == 0.0f) return;
+
+   for (k=0; k<3; k++) {
+       side[k] /= sideLen;
+       d[k] /= len;
+   }
+
+   hp = 0.5f*width*view.pixelSize(p);
+   hq = 0.5f*width*view.pixelSize(q);
+   addCorner(p, side, d, -hp, -hp);
+   addCorner(p, side, d,  hp, -hp);
+   addCorner(q, side, d,  hq,  hq);
+   addCorner(q, side, d, -hq,  hq);
+}
+
+// Quads facing away from the viewer are drawn as well
+void WideLines::end(void)
+{
+   const GLubyte *base;
+   int n = vertices.size();
+
+   quads = n/4;
+   if (n == 0) return;
+
+   if (!initialized && glGetString(GL_VERSION) != 0) {
+      initialized = true;
+      if (hasBufferObjects()) genBuffers(1, &buffer);
+   }
+
+   glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+   glPushAttrib(GL_ENABLE_BIT);
+   glDisable(GL_CULL_FACE);
+   if (buffer != 0) {
+      bindBuffer(GL_ARRAY_BUFFER, buffer);
+      // a new store every frame, the driver does not wait for the last frame
+      bufferData(GL_ARRAY_BUFFER, n*sizeof(Vertex), &vertices[0], GL_STREAM_DRAW);
+      base = 0;
+   }
+   else
+      base = (const GLubyte*) &vertices[0];
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_NORMAL_ARRAY);
+   glVertexPointer(3, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, position));
+   glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + offsetof(Vertex, color));
+   glDrawArrays(GL_QUADS, 0, n);
+   drawCalls++;
+
+   if (buffer != 0) bindBuffer(GL_ARRAY_BUFFER, 0);
+   glPopAttrib();
+   glPopClientAttrib();
+}
+
+int WideLines::getNumberOfQuads(void)
+{
+   return quads;
+}
+
+unsigned int WideLines::getDrawCalls(void)
+{
+   return drawCalls;
+}
+
+void WideLines::resetStatistics(void)
+{
+   drawCalls = 0;
+}
+
+//
+// private
+//
+void WideLines::addCorner(const float p[3], const float side[3], const float cap[3],
+                          float s, float c)
+{
+   Vertex v;
+   int k;
+
+   for (k=0; k<3; k++) v.position[k] = p[k] + s*side[k] + c*cap[k];
+   for (k=0; k<4; k++) v.color[k] = color[k];
+   vertices.push_back(v);
+}
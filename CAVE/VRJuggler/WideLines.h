@@ -0,0 +1,110 @@
+// --------------------------------------------------------------------
+//  WideLines.h
+//
+//  Line segments with a width in pixels, drawn as quads facing the
+//  viewer instead of wide OpenGL lines.
+// --------------------------------------------------------------------
+//  $RCSfile$
+//  $Revision$
+//  $Date$
+// --------------------------------------------------------------------
+#ifndef WIDELINES
+#define WIDELINES
+
+#include <vector>
+#include <GL/gl.h>
+
+#include "ViewFrustum.h"
+
+using namespace std;
+
+//! Wide line segments as quads facing the viewer
+/*!
+  glLineWidth() is clamped to 1 pixel by many drivers, and the software
+  rasterizers of Mesa draw wide lines on a slow path. This class builds
+  a quad for every segment on the CPU: the quad is spanned by the
+  segment and a side vector orthogonal to both the segment and the
+  direction to the viewer, so it faces the viewer as far as the segment
+  allows. Its width is the line width in pixels at the depth of the end
+  points. The quads are
+  extended by half the width beyond the end points, so the quads of a
+  polyline overlap at the joins and there are no gaps.
+
+  The quads depend on the view, they are built again in every frame
+  between ::begin() and ::end(). ::end() sends them in one draw call,
+  with a buffer object written with GL_STREAM_DRAW if available,
+  otherwise as client side array.
+*/
+class WideLines
+{
+// ----------------------------------------------
+// public
+// ----------------------------------------------
+public:
+   //! Default constructor, width 1 pixel, color white
+   WideLines(void);
+   //! Destructor, the buffer object is deleted
+   ~WideLines(void);
+
+   //! Set the width in pixels
+   void  setWidth(float);
+   //! Query the width in pixels
+   float getWidth(void);
+   //! Set the color of the following segments, RGBA
+   void  setColor(const GLfloat color[4]);
+   //! Set the color of the following segments, RGBA
+   void  setColor(const GLubyte color[4]);
+
+   //! Start the quads for the current view, the GL matrices are read
+   void  begin(void);
+   //! Add the quad of the segment (p,q)
+   void  addSegment(const float p[3], const float q[3]);
+   //! Draw the quads
+   /*!
+     The client state of the vertex arrays is saved and restored,
+     lighting is not changed.
+   */
+   void  end(void);
+
+   //! Query the number of quads of the last ::end()
+   int   getNumberOfQuads(void);
+   //! Query the number of draw calls since the last ::resetStatistics()
+   unsigned int getDrawCalls(void);
+   //! Set the counters to 0
+   void  resetStatistics(void);
+
+// ----------------------------------------------
+// private
+// ----------------------------------------------
+private:
+   //! One vertex, interleaved
+   struct Vertex
+   {
+      float position[3];
+      GLubyte color[4];
+   };
+
+   //! Width in pixels
+   float width;
+   //! Current color
+   GLubyte color[4];
+   //! The view of the quads
+   ViewFrustum view;
+   //! The corners of the quads, the capacity is kept
+   vector<Vertex> vertices;
+   //! Number of quads of the last ::end()
+   int quads;
+
+   //! Has the GL been queried for vertex buffer objects?
+   bool initialized;
+   //! The buffer object, 0 for client side arrays
+   GLuint buffer;
+
+   //! Counter
+   unsigned int drawCalls;
+
+   //! Add a corner of a quad
+   void addCorner(const float p[3], const float side[3], const float cap[3],
+                  float s, float c);
+};
+#endif
@@ -0,0 +1,252 @@
+/* -------------------------------------------------------------------
+ *    Dateiname: siveHeadless.cpp
+ *
+ *    SIVE/GL ohne Fenster: die Szene wird in einem OSMesa-Kontext
+ *    entlang eines Kamerapfads dargestellt, die Zeiten pro Frame
+ *    werden als CSV-Datei ausgegeben, die Frames optional als PNG.
+ *    Mit -k werden mehrere Kanaele wie die Waende einer CAVE
+ *    nacheinander dargestellt, jeder mit eigener Blickrichtung.
+ * -------------------------------------------------------------------*/
+#include <GL/osmesa.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include "SiveScene.h"
+#include "CameraPath.h"
+#include "PngWriter.h"
+
+using namespace std;
+
+static void usage(const char *name)
+{
+    cerr << "Aufruf: " << name << " [-W Breite] [-H Hoehe] [-n Frames]"
+         << " [-p Pfad] [-t Zeiten.csv] [-i Prefix] [-c] [-k Kanaele] [-L] [-l] [-b] [-r] [-P] [-z]"
+         << " [Objekt.vtk]" << endl;
+    cerr << "  -W, -H  Groesse des Bilds, Vorgabe 1280x960" << endl;
+    cerr << "  -n      Anzahl der Frames, Vorgabe 100" << endl;
+    cerr << "  -p      Kamerapfad, eine Zeile pro Key-Frame: Auge und Zentrum;"
+         << " Vorgabe ist ein Kreis um das Objekt" << endl;
+    cerr << "  -t      Zeiten pro Frame als CSV-Datei" << endl;
+    cerr << "  -i      Frames als Prefix0000.png, ... schreiben" << endl;
+    cerr << "  -c      Lichtkaefig darstellen" << endl;
+    cerr << "  -k      Anzahl der Kanaele 1 bis 6: vorne, links, rechts, Boden,"
+         << " hinten, Decke; Vorgabe 1" << endl;
+    cerr << "  -L      Isophoten ohne Chunks, Culling und Level of Detail" << endl;
+    cerr << "  -l      Linien mit glLineWidth statt Quads" << endl;
+    cerr << "  -b      Rueckseiten von Objekt und Isophoten nicht auslassen" << endl;
+    cerr << "  -r      Reflexionslinien aus der Cube-Map des Lichtkaefigs"
+         << " statt Isophoten" << endl;
+    cerr << "  -P      Objekt mit gepackten Arrays statt VTK-Daten" << endl;
+    cerr << "  -z      Gepackte Arrays komprimieren, schliesst -P ein" << endl;
+}
+
+// Blickrichtung der Kanaele: Drehwinkel und Achse relativ zur Kamera
+static const float channelRotation[6][4] = {
+    {   0.0f, 0.0f, 1.0f, 0.0f},   // vorne
+    {  90.0f, 0.0f, 1.0f, 0.0f},   // links
+    { -90.0f, 0.0f, 1.0f, 0.0f},   // rechts
+    { -90.0f, 1.0f, 0.0f, 0.0f},   // Boden
+    { 180.0f, 0.0f, 1.0f, 0.0f},   // hinten
+    {  90.0f, 1.0f, 0.0f, 0.0f}    // Decke
+};
+
+static double now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return 1000.0*t.tv_sec + 1.0E-6*t.tv_nsec;
+}
+
+// Zentralprojektion mit Oeffnungswinkel 60 Grad wie in SiveEngine,
+// fuer die Waende einer CAVE 90 Grad
+static void perspective(int width, int height, const float box[6], float angle)
+{
+    float diagonal, zNear, zFar, top;
+
+    diagonal = sqrt((box[1]-box[0])*(box[1]-box[0]) +
+                    (box[3]-box[2])*(box[3]-box[2]) +
+                    (box[5]-box[4])*(box[5]-box[4]));
+    zNear = 0.01f*diagonal;
+    zFar  = 10.0f*diagonal;
+    top = zNear*tan(0.5*angle*M_PI/180.0);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glFrustum(-top*width/height, top*width/height, -top, top, zNear, zFar);
+    glMatrixMode(GL_MODELVIEW);
+}
+
+int main(int argc, char **argv)
+{
+    int width = 1280, height = 960, frames = 100, channels = 1, c, f, k;
+    const char *pathFile = NULL, *timeFile = NULL, *imagePrefix = NULL;
+    const char *objectFile = "Data/G1_transformed.vtk";
+    bool showCage = false, chunks = true, quads = true, backFaces = true;
+    bool reflection = false, compact = false, compression = false;
+    char name[1024];
+    double start, channelStart, sum = 0.0;
+    double drawn[2] = {0.0, 0.0}, skipped[2] = {0.0, 0.0};
+    float *box;
+    FILE *times = NULL;
+    LineChunks *lineChunks;
+    InterrogationObject *object;
+
+    while ((c = getopt(argc, argv, "W:H:n:p:t:i:ck:LlbrPzh")) != -1) {
+        switch (c) {
+            case 'W': width = atoi(optarg); break;
+            case 'H': height = atoi(optarg); break;
+            case 'n': frames = atoi(optarg); break;
+            case 'p': pathFile = optarg; break;
+            case 't': timeFile = optarg; break;
+            case 'i': imagePrefix = optarg; break;
+            case 'c': showCage = true; break;
+            case 'k': channels = atoi(optarg); break;
+            case 'L': chunks = false; break;
+            case 'l': quads = false; break;
+            case 'b': backFaces = false; break;
+            case 'r': reflection = true; break;
+            case 'P': compact = true; break;
+            case 'z': compact = compression = true; break;
+            default:  usage(argv[0]); exit(1);
+        }
+    }
+    if (optind < argc) objectFile = argv[optind];
+    if (width <= 0 || height <= 0 || frames <= 0 || channels < 1 || channels > 6) {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    // Kontext mit Tiefenpuffer, die Farben liegen in image
+    OSMesaContext context = OSMesaCreateContextExt(OSMESA_RGBA, 24, 0, 0, NULL);
+    if (context == NULL) {
+        cerr << "Der OSMesa-Kontext kann nicht erzeugt werden" << endl;
+        exit(1);
+    }
+    vector<unsigned char> image(4*width*height);
+    if (!OSMesaMakeCurrent(context, &image[0], GL_UNSIGNED_BYTE, width, height)) {
+        cerr << "Der OSMesa-Kontext kann nicht aktiviert werden" << endl;
+        exit(1);
+    }
+    cout << "OpenGL: " << glGetString(GL_RENDERER) << ", "
+         << glGetString(GL_VERSION) << endl;
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_DEPTH_TEST);
+
+    SiveScene scene;
+    scene.initGL();
+    scene.setCompactArrays(compact);
+    scene.setCompression(compression);
+    scene.init(objectFile);
+    scene.getCageRenderer()->showCage(showCage);
+    scene.setReflectionLines(reflection);
+    scene.getIsophotes()->getContourEngine()->setChunks(chunks);
+    if (!quads) {
+        scene.getCageRenderer()->setLineWidth(0.0f);
+        scene.getIsophotes()->getContourEngine()->setLineWidth(0.0f);
+    }
+    lineChunks = scene.getIsophotes()->getContourEngine()->getLineChunks();
+    object = scene.getInterrogationObject();
+    lineChunks->setBackFaceCulling(backFaces);
+    object->setBackFaceCulling(backFaces);
+    if (chunks) {
+        cout << "Chunks: " << lineChunks->getNumberOfChunks() << ", Segmente pro Level:";
+        for (k=0; k<lineChunks->getNumberOfLevels(); k++)
+            cout << " " << lineChunks->getNumberOfSegments(k);
+        cout << endl;
+    }
+
+    box = scene.getBoundingBox();
+    CameraPath path;
+    if (pathFile != NULL) {
+        if (!path.read(pathFile)) {
+            cerr << "Der Kamerapfad " << pathFile << " kann nicht gelesen werden" << endl;
+            exit(1);
+        }
+    }
+    else
+        path.orbit(box, 37);
+    perspective(width, height, box, (channels > 1) ? 90.0f : 60.0f);
+
+    if (timeFile != NULL) {
+        times = fopen(timeFile, "w");
+        if (times == NULL) {
+            cerr << "Die Datei " << timeFile << " kann nicht geschrieben werden" << endl;
+            exit(1);
+        }
+        fprintf(times, "frame,channel,ms,drawcalls,chunks,segments,"
+                       "backsegments,triangles,backtriangles\n");
+    }
+
+    // Frame 0 laedt die Buffer und wird nicht in die Statistik aufgenommen
+    vector<double> ms(frames);
+    for (f=0; f<frames; f++) {
+        start = now();
+
+        // Alle Kanaele nacheinander in denselben Puffer, wie eine
+        // Grafikkarte, die mehrere Waende versorgt
+        for (k=0; k<channels; k++) {
+            scene.getCageRenderer()->resetStatistics();
+            lineChunks->resetStatistics();
+            object->resetStatistics();
+            channelStart = now();
+
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glLoadIdentity();
+            glRotatef(channelRotation[k][0], channelRotation[k][1],
+                      channelRotation[k][2], channelRotation[k][3]);
+            path.apply((frames > 1) ? (float) f/(frames-1) : 0.0f);
+            scene.draw();
+            glFinish();
+
+            if (times != NULL)
+                fprintf(times, "%d,%d,%.3f,%u,%u,%u,%u,%u,%u\n", f, k, now() - channelStart,
+                        scene.getCageRenderer()->getDrawCalls(),
+                        lineChunks->getDrawnChunks(), lineChunks->getDrawnSegments(),
+                        lineChunks->getBackFacingSegments(),
+                        object->getDrawnTriangles(), object->getBackFacingTriangles());
+            drawn[0]   += lineChunks->getDrawnSegments();
+            skipped[0] += lineChunks->getBackFacingSegments();
+            drawn[1]   += object->getDrawnTriangles();
+            skipped[1] += object->getBackFacingTriangles();
+        }
+
+        ms[f] = now() - start;
+        if (f > 0) sum += ms[f];
+
+        if (imagePrefix != NULL) {
+            sprintf(name, "%.1000s%04d.png", imagePrefix, f);
+            if (!writePNG(name, width, height, &image[0]))
+                cerr << "Die Datei " << name << " kann nicht geschrieben werden" << endl;
+        }
+    }
+    if (times != NULL) fclose(times);
+
+    if (frames > 1) {
+        sort(ms.begin()+1, ms.end());
+        cout << "Frames: " << frames-1 << " (ohne Frame 0)" << endl;
+        cout << "Zeit pro Frame [ms]: Minimum " << ms[1]
+             << ", Median " << ms[1+(frames-1)/2]
+             << ", Mittel " << sum/(frames-1)
+             << ", Maximum " << ms[frames-1] << endl;
+        cout << "Frames pro Sekunde: " << 1000.0*(frames-1)/sum << endl;
+    }
+    // Anteil der sichtbaren Primitive, die als Rueckseite ausgelassen wurden
+    if (drawn[0] + skipped[0] > 0.0)
+        cout << "Segmente, Rueckseiten ausgelassen: "
+             << 100.0*skipped[0]/(drawn[0] + skipped[0]) << " %" << endl;
+    if (drawn[1] + skipped[1] > 0.0)
+        cout << "Dreiecke, Rueckseiten ausgelassen: "
+             << 100.0*skipped[1]/(drawn[1] + skipped[1]) << " %" << endl;
+
+    OSMesaDestroyContext(context);
+    return 0;
+}
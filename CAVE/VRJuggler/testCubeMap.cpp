@@ -0,0 +1,120 @@
+/* -------------------------------------------------------------------
+ *    Dateiname: testCubeMap.cpp
+ *
+ *    Test fuer CubeMapGenerator: die Faces werden mit dem Abstand
+ *    von Strahl und Lichtlinie direkt berechnet und verglichen, mit
+ *    einem und mehreren Threads. ::update() darf nur nach Aenderungen
+ *    des Lichtkaefigs neu rechnen. Ein OpenGL-Kontext wird nicht
+ *    gebraucht. Der Exit-Code ist 0, wenn alle Tests bestanden sind.
+ * -------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+
+#include "TopParallelLightCage.h"
+#include "CubeMapGenerator.h"
+#include "LightForms.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    cerr << (ok ? "ok      " : "FAILED  ") << what << endl;
+    if (!ok) failures++;
+}
+
+// Richtung des Texels (i, j) einer Face wie in CubeMapGenerator
+static void texelDirection(int f, int i, int j, int size, double r[3])
+{
+    static const double base[6][3] = {{ 1, 0, 0}, {-1, 0, 0}, {0,  1, 0},
+                                      { 0,-1, 0}, { 0, 0, 1}, {0,  0,-1}};
+    static const double u[6][3]    = {{ 0, 0,-1}, { 0, 0, 1}, {1,  0, 0},
+                                      { 1, 0, 0}, { 1, 0, 0}, {-1, 0, 0}};
+    static const double v[6][3]    = {{ 0,-1, 0}, { 0,-1, 0}, {0,  0, 1},
+                                      { 0, 0,-1}, { 0,-1, 0}, {0, -1, 0}};
+    double sc = 2.0*(i+0.5)/size - 1.0, tc = 2.0*(j+0.5)/size - 1.0;
+
+    for (int k=0; k<3; k++) r[k] = base[f][k] + sc*u[f][k] + tc*v[f][k];
+}
+
+// Leuchtdichte in Richtung r, Maximum ueber alle Linien; -1, wenn der
+// Strahl fast parallel zu einer Linie ist
+static double reference(LightCage *cage, const float o[3], const double r[3])
+{
+    const float *p = cage->getPoints(), *d = cage->getDirections(),
+                *rad = cage->getRadii();
+    double c[3], q[3], len, dist, value, result = 0.0;
+
+    for (int l=0; l<cage->size(); l++) {
+        c[0] = d[3*l+1]*r[2] - d[3*l+2]*r[1];
+        c[1] = d[3*l+2]*r[0] - d[3*l]*r[2];
+        c[2] = d[3*l]*r[1] - d[3*l+1]*r[0];
+        len = sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2]);
+        if (len < 1.0E-2) return -1.0;
+        for (int k=0; k<3; k++) q[k] = p[3*l+k] - o[k];
+        dist = fabs(c[0]*q[0] + c[1]*q[1] + c[2]*q[2])/len;
+        value = lightForm(dist/rad[l], cage->getAttenuation(l));
+        if (value > result) result = value;
+    }
+    return result;
+}
+
+int main(void)
+{
+    const int size = 64;
+    float box[6] = {-2.0f, 2.0f, 0.5f, 4.0f, -2.0f, 2.0f}, origin[3];
+    double r[3], value;
+    int f, i, j, worst = 0, lit = 0, differ = 0;
+
+    TopParallelLightCage *cage = new TopParallelLightCage(box, 10);
+    cage->setCageRadius(0.1f);
+    cage->setCageAttenuation(LightLine::Polynomial);
+
+    CubeMapGenerator generator(cage, size);
+    generator.setOrigin(0.0f, 0.0f, 0.0f);
+    generator.getOrigin(origin);
+    generator.setThreads(1);
+
+    check(generator.update(), "die erste Aktualisierung berechnet die Faces");
+    check(!generator.update(), "ohne Aenderung wird nicht neu berechnet");
+
+    for (f=0; f<6; f++) {
+        const unsigned char *face = generator.getFace(f);
+        for (j=0; j<size; j++)
+            for (i=0; i<size; i++) {
+                texelDirection(f, i, j, size, r);
+                value = reference(cage, origin, r);
+                if (value < 0.0) continue;
+                int expected = (int)(255.0*value + 0.5);
+                int error = abs(expected - (int)face[j*size+i]);
+                if (error > worst) worst = error;
+                if (face[j*size+i] > 0) lit++;
+            }
+    }
+    cerr << "Groesster Fehler: " << worst << ", helle Texel: " << lit << endl;
+    check(worst <= 2, "die Faces stimmen mit dem direkt berechneten Abstand ueberein");
+    check(lit > 0, "die Lichtlinien sind in der Cube-Map sichtbar");
+
+    // gleiche Bilder mit mehreren Threads
+    vector<unsigned char> single[6];
+    for (f=0; f<6; f++)
+        single[f].assign(generator.getFace(f), generator.getFace(f) + size*size);
+    generator.setThreads(4);
+    generator.compute();
+    for (f=0; f<6; f++)
+        for (i=0; i<size*size; i++)
+            if (single[f][i] != generator.getFace(f)[i]) differ++;
+    check(differ == 0, "mehrere Threads ergeben dieselben Faces");
+
+    cage->translate(0.5f, 0.0f, 0.0f);
+    check(generator.update(), "nach einer Verschiebung wird neu berechnet");
+    generator.setOrigin(0.0f, 0.0f, 0.0f);
+    check(generator.update(), "nach einem neuen Ursprung wird neu berechnet");
+
+    delete cage;
+    if (failures > 0) cerr << failures << " Tests fehlgeschlagen" << endl;
+    else              cerr << "Alle Tests bestanden" << endl;
+    return (failures > 0) ? 1 : 0;
+}